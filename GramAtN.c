@@ -1,10 +1,11 @@
 // -------------------------------------------------------------------
-// Program last modified January 9, 2026. 
+// Program last modified October 16, 2026. 
 // Copyright (c) 2025-2026 Terrence P. Murphy
 // MIT License -- see hgt.h for details.
 // -------------------------------------------------------------------
 
 #include <stdio.h>
+#include <math.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
@@ -14,33 +15,70 @@
 
 #include "hgt.h"
 
-extern struct	HGT_INIT	hgt_init;
-
 
 const char 	chGramSmall[4][50] = {
 	{"3.4360829361"},
 	{"17.8455995404108608168263384125190970356932874"},
 	{"23.1702827012463092789966435383015320517470983"}, 
 	{"27.6701822178483449617890"} };
+
+// -------------------------------------------------------------------
+// The principal branch of the Lambert W function, W(x) e^{W(x)} = x,
+// for x > 0, by Halley's method.  Used (in double precision) only 
+// for the starting guess of GramAtN.
+// -------------------------------------------------------------------
+static double LambertW(double x)
+{
+double	w, ew, f, wNew;
+int		i;
+
+w = log1p(x);
+if(x > 3) {
+	w = log(x) - log(log(x));
+	}
+for(i = 0; i < 64; i++) {
+	ew	 = exp(w);
+	f	 = w * ew - x;
+	wNew = w - f / (ew * (w + 1) - (w + 2) * f / (2 * w + 2));
+	if(fabs(wNew - w) <= 1e-15 * fabs(wNew)) {
+		return(wNew);
+		}
+	w = wNew;
+	}
+return(w);
+}
 	
 // #####################################################################
 // For our given N, compute the Gram number.
+//
+// We start from the asymptotic value
+//		g_n = 2 pi exp(1 + W((8n + 1) / (8e)))
+// and refine it by Newton's method on \theta(t) - n pi, using
+// ThetaPairOfT.  Each Newton step is kept inside a bracket known 
+// to hold g_n (stepping outside it gives a bisection step instead), 
+// and if Newton has not converged after HGT_GRAM_NEWTON_MAX steps we 
+// fall back to bisection on what is left of the bracket.
 // #####################################################################
 int GramAtN(mpfr_t *Result, mpfr_t N, mpfr_t Accuracy)
 {
+struct HGT_WORKMARK	Mark;
 mpfr_t		tAbove, tBelow;
 mpfr_t		LogN, NOverLogN, k, x, xN, Temp1, Temp2;
 mpfr_t		tNewBelow, tNewAbove, tMid, tGap, tHalfGap, thetaMid, thetaDelta, nPi;
+mpfr_t		tNext, thetaPrime;
+double		dW;
 long int	i;
 bool		bFinished = false;
 
 // -------------------------------------------------------------------
 // initialize all mpfr_t variables used in computing the Gram point
 // -------------------------------------------------------------------
-mpfr_inits2 (hgt_init.DefaultBits, tAbove, tBelow, (mpfr_ptr) 0);
-mpfr_inits2 (hgt_init.DefaultBits, LogN, NOverLogN, k, x, xN, Temp1, Temp2, (mpfr_ptr) 0);
-mpfr_inits2 (hgt_init.DefaultBits, tNewBelow, tNewAbove, tMid, tGap, tHalfGap, 
+Mark = WorkMark();
+WorkInits(hgt_init.DefaultBits, tAbove, tBelow, (mpfr_ptr) 0);
+WorkInits(hgt_init.DefaultBits, LogN, NOverLogN, k, x, xN, Temp1, Temp2, (mpfr_ptr) 0);
+WorkInits(hgt_init.DefaultBits, tNewBelow, tNewAbove, tMid, tGap, tHalfGap, 
 	thetaMid, thetaDelta, nPi, (mpfr_ptr) 0);
+WorkInits(hgt_init.DefaultBits, tNext, thetaPrime, (mpfr_ptr) 0);
 
 // -------------------------------------------------------------------
 // Step 1. For n = -1, 0, 1, 2 we use a lookup table (to avoid "edge" 
@@ -87,7 +125,7 @@ else {
 	}
 
 // -------------------------------------------------------------------
-// Step 2. Final calculation of the Gram point.
+// Step 2. Newton's method, from the Lambert W starting guess.
 // -------------------------------------------------------------------
 	// ---------------------------------------------------------------
 	// Set the starting values for tNewBelow and tNewAbove, plus the 
@@ -97,8 +135,53 @@ if(bFinished == false) {
 	mpfr_set (tNewBelow, tBelow, MPFR_RNDN);
 	mpfr_set (tNewAbove, tAbove, MPFR_RNDN);
 	mpfr_mul (nPi, hgt_init.myPi, N, MPFR_RNDN);
+
+	// ---------------------------------------------------------------
+	// Set tMid = 2 pi exp(1 + W((8n + 1) / (8e))).  W is computed in 
+	// double precision, which is plenty for a starting guess.
+	// ---------------------------------------------------------------
+	dW = LambertW((8 * mpfr_get_d (N, MPFR_RNDN) + 1) / (8 * exp(1.0)));
+	mpfr_set_d (tMid, 1 + dW, MPFR_RNDN);
+	mpfr_exp (tMid, tMid, MPFR_RNDN);
+	mpfr_mul (tMid, tMid, hgt_init.myPi, MPFR_RNDN);
+	mpfr_mul_2ui (tMid, tMid, 1, MPFR_RNDN);
+	}
+
+	// ---------------------------------------------------------------
+	// Each time through the loop, we compute thetaDelta = 
+	// [\theta(tMid) - nPi] and stop if it is small enough.  Otherwise,
+	// tMid replaces one end of the bracket [tNewBelow, tNewAbove], 
+	// and we take the Newton step tMid - thetaDelta / \theta'(tMid).  
+	// If that step leaves the bracket, we use the bracket midpoint.
+	// ---------------------------------------------------------------
+for(i = 0; i < HGT_GRAM_NEWTON_MAX && bFinished == false; i++) {
+	if(mpfr_cmp (tMid, tNewBelow) <= 0 || mpfr_cmp (tMid, tNewAbove) >= 0) {
+		mpfr_add (tMid, tNewBelow, tNewAbove, MPFR_RNDN);
+		mpfr_div_2ui (tMid, tMid, 1, MPFR_RNDN);
+		}
+	ThetaPairOfT(&thetaMid, &thetaPrime, tMid);
+	mpfr_sub (thetaDelta, thetaMid, nPi, MPFR_RNDN);
+	mpfr_abs (Temp1, thetaDelta, MPFR_RNDN);
+
+	if( mpfr_cmp (Temp1, Accuracy) < 0){
+		bFinished = true;
+		break;
+		}
+	else if (mpfr_sgn (thetaDelta) > 0) {
+		mpfr_set (tNewAbove, tMid, MPFR_RNDN);
+		}
+	else {
+		mpfr_set (tNewBelow, tMid, MPFR_RNDN);
+		}
+	mpfr_div (Temp1, thetaDelta, thetaPrime, MPFR_RNDN);
+	mpfr_sub (tNext, tMid, Temp1, MPFR_RNDN);
+	mpfr_swap (tMid, tNext);
 	}
 
+// -------------------------------------------------------------------
+// Step 3. If Newton's method did not converge, bisect.
+// -------------------------------------------------------------------
+
 	// ---------------------------------------------------------------
 	// Loop up to GRAM_LOOP_MAX number of times.  In each case, we find 
 	// the midpoint tMid between tNewBelow and tNewAbove, then compute 
@@ -144,14 +227,11 @@ for(i = 0; i < HGT_GRAM_LOOP_MAX && bFinished == false; i++) {
 if(bFinished == false) {
 	mpfr_printf("FAILURE!!!: Gram = %.20Rf, (Gram - n * pi) = %.20Rf \n", tMid, thetaDelta);
 	}
-mpfr_swap (*Result, tMid);
+mpfr_set (*Result, tMid, MPFR_RNDN);
 
 // -------------------------------------------------------------------
 // Clear our local MPFR variables.
 // -------------------------------------------------------------------
-mpfr_clears (tAbove, tBelow, (mpfr_ptr) 0);
-mpfr_clears (LogN, NOverLogN, k, x, xN, Temp1, Temp2, (mpfr_ptr) 0);
-mpfr_clears (tNewBelow, tNewAbove, tMid, tGap, tHalfGap, 
-	thetaMid, thetaDelta, nPi, (mpfr_ptr) 0);
+WorkRelease(Mark);
 return(1);
 }
@@ -14,8 +14,6 @@
 
 #include "hgt.h"
 
-extern struct	HGT_INIT	hgt_init;
-
 
 // #####################################################################
 // For the given 't', we returns the largest 'n' value where g_n <= T.
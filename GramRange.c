@@ -0,0 +1,165 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file computes the consecutive Gram points g_N, g_{N+1}, ...,
+// g_{N+Count-1}.  Rather than solve each one from scratch (as GramAtN
+// does), each point is started from the one before.  With t = g_{n-1},
+// a = \theta'(t), h = pi / a and u = h / (t a), the guess
+//
+//		g_n = t + h (1 - u/4 + u^2 (1/8 + a/12))
+//
+// comes from inverting the Taylor series of \theta about t (using 
+// \theta''(t) = 1/(2t) and \theta'''(t) = -1/(2t^2), which are close 
+// enough here).  It is usually so close that one or two Newton steps 
+// finish the job.  Each Newton step uses ThetaPairOfT, which also 
+// gives \theta' for the next guess at no extra cost.  When the first 
+// Newton step is certain to reach the requested accuracy, we skip 
+// the check that would confirm it.
+//
+// The points are split into chunks of HGT_GRAM_CHUNK, each a pool
+// task.  The first point of each chunk (and any point with n < 4,
+// or where Newton does not converge) comes from GramAtN.
+// -------------------------------------------------------------------
+
+struct gramChunk {
+	mpfr_t		*Results;		// first result of the chunk
+	mpfr_t		N;				// n of the first result
+	mpfr_ptr	Accuracy;
+	uint64_t	Count;
+};
+
+static void	GramChunkTask(void *Arg);
+
+// #####################################################################
+// Compute the Gram points g_N through g_{N+Count-1} into Results[0]
+// through Results[Count-1].  The caller must initialize Results.
+// #####################################################################
+int GramRange(mpfr_t *Results, mpfr_t N, uint64_t Count, mpfr_t Accuracy)
+{
+struct gramChunk	*chunks;
+struct HGT_BATCH	*Batch;
+uint64_t			nChunks, i;
+
+if(Count < 1) {
+	return(1);
+	}
+nChunks = (Count + HGT_GRAM_CHUNK - 1) / HGT_GRAM_CHUNK;
+chunks	= malloc(nChunks * sizeof(struct gramChunk));
+Batch	= PoolBatchCreate();
+
+for(i = 0; i < nChunks; i++) {
+	chunks[i].Results  = Results + i * HGT_GRAM_CHUNK;
+	chunks[i].Accuracy = Accuracy;
+	chunks[i].Count	   = (i + 1) * HGT_GRAM_CHUNK < Count ?
+						HGT_GRAM_CHUNK : Count - i * HGT_GRAM_CHUNK;
+	mpfr_init2 (chunks[i].N, mpfr_get_prec(N) + 64);
+	mpfr_set_uj (chunks[i].N, i * HGT_GRAM_CHUNK, MPFR_RNDN);
+	mpfr_add (chunks[i].N, chunks[i].N, N, MPFR_RNDN);
+	PoolSubmit(Batch, GramChunkTask, &chunks[i]);
+	}
+PoolWaitBatch(Batch);
+PoolBatchFree(Batch);
+
+for(i = 0; i < nChunks; i++) {
+	mpfr_clear (chunks[i].N);
+	}
+free(chunks);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// The pool task for one chunk of Gram points.
+// -------------------------------------------------------------------
+static void GramChunkTask(void *Arg)
+{
+struct gramChunk	*chunk = (struct gramChunk *) Arg;
+mpfr_t				n, nPi, t, tPrev, Theta, ThetaPrime, h, Temp1, Temp2;
+uint64_t			k;
+int					i;
+bool				bFinished;
+
+mpfr_init2 (n, mpfr_get_prec(chunk->N));
+mpfr_inits2 (hgt_init.DefaultBits, nPi, t, tPrev, Theta, ThetaPrime, h, Temp1,
+	Temp2, (mpfr_ptr) 0);
+mpfr_set (n, chunk->N, MPFR_RNDN);
+
+for(k = 0; k < chunk->Count; k++, mpfr_add_ui (n, n, 1, MPFR_RNDN)) {
+	bFinished = false;
+	mpfr_mul (nPi, hgt_init.myPi, n, MPFR_RNDN);
+
+	if(k > 0 && mpfr_cmp_si (n, 4) >= 0) {
+		// -----------------------------------------------------------
+		// Guess t from tPrev; ThetaPrime holds \theta'(tPrev).
+		// -----------------------------------------------------------
+		mpfr_div (h, hgt_init.myPi, ThetaPrime, MPFR_RNDN);
+		mpfr_div (Temp1, h, tPrev, MPFR_RNDN);
+		mpfr_div (Temp1, Temp1, ThetaPrime, MPFR_RNDN);		// u
+		mpfr_div_ui (Temp2, ThetaPrime, 12, MPFR_RNDN);
+		mpfr_add_d (Temp2, Temp2, 0.125, MPFR_RNDN);
+		mpfr_mul (Temp2, Temp2, Temp1, MPFR_RNDN);
+		mpfr_sub_d (Temp2, Temp2, 0.25, MPFR_RNDN);
+		mpfr_mul (Temp2, Temp2, Temp1, MPFR_RNDN);		// -u/4 + u^2 (1/8 + a/12)
+		mpfr_fma (t, h, Temp2, h, MPFR_RNDN);
+		mpfr_add (t, tPrev, t, MPFR_RNDN);
+
+		// -----------------------------------------------------------
+		// Newton steps.  We give up (and use GramAtN) if we do not
+		// converge, or if the result is not above tPrev.
+		// -----------------------------------------------------------
+		for(i = 0; i < HGT_GRAM_NEWTON_MAX; i++) {
+			ThetaPairOfT(&Theta, &ThetaPrime, t);
+			mpfr_sub (Theta, Theta, nPi, MPFR_RNDN);
+			mpfr_abs (Temp1, Theta, MPFR_RNDN);
+			if(mpfr_cmp (Temp1, chunk->Accuracy) < 0) {
+				bFinished = mpfr_cmp (t, tPrev) > 0;
+				break;
+				}
+			mpfr_div (Temp1, Theta, ThetaPrime, MPFR_RNDN);
+			mpfr_sub (t, t, Temp1, MPFR_RNDN);
+
+			// -------------------------------------------------------
+			// After the step, |\theta(t) - nPi| should be about
+			// Theta^2 \theta'' / (2 \theta'^2), with \theta'' about 
+			// 1/(2t).  If that is far below Accuracy (and Accuracy is
+			// well above the rounding error in \theta(t)), we accept
+			// t without evaluating \theta(t) again.
+			// -------------------------------------------------------
+			if(i == 0 && mpfr_get_exp (chunk->Accuracy) > 
+					mpfr_get_exp (nPi) - hgt_init.DefaultBits + HGT_GRAM_SKIP_BITS) {
+				mpfr_sqr (h, Temp1, MPFR_RNDN);
+				mpfr_div (h, h, t, MPFR_RNDN);
+				mpfr_mul (h, h, ThetaPrime, MPFR_RNDN);
+				mpfr_mul_2si (h, h, HGT_GRAM_SKIP_BITS - 2, MPFR_RNDN);
+				if(mpfr_cmp (h, chunk->Accuracy) < 0) {
+					bFinished = mpfr_cmp (t, tPrev) > 0;
+					break;
+					}
+				}
+			}
+		}
+
+	if(bFinished == false) {
+		GramAtN(&t, n, chunk->Accuracy);
+		ThetaPrimeOfT(&ThetaPrime, t);
+		}
+	mpfr_set (chunk->Results[k], t, MPFR_RNDN);
+	mpfr_swap (tPrev, t);
+	}
+
+mpfr_clear (n);
+mpfr_clears (nPi, t, tPrev, Theta, ThetaPrime, h, Temp1, Temp2, (mpfr_ptr) 0);
+}
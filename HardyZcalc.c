@@ -1,5 +1,5 @@
 // -------------------------------------------------------------------
-// Program last modified January 14, 2026. 
+// Program last modified October 16, 2026. 
 // Copyright (c) 2024-2026 Terrence P. Murphy
 // MIT License -- see hgt.h for details.
 // -------------------------------------------------------------------
@@ -16,86 +16,219 @@
 
 #include "hgt.h"
 
-extern struct	HGT_INIT	hgt_init;
+// -------------------------------------------------------------------
+// A chunk of consecutive points of a HardyZWithRange run, as a pool
+// task.  The points are records of a result ring (see hgtRing.c).
+// -------------------------------------------------------------------
+struct hzChunk {
+	struct computeHZ	*pts;		// HGT_STREAM_CHUNK ring slots
+	struct HGT_RING		*Ring;
+	uint64_t			Index;		// point number of pts[0]
+	int					Count;
+	bool				Ball;		// proven radii wanted (HardyZWithBall)
+};
+
+static int	HardyZStream(mpfr_t t, mpfr_t Incr, uint64_t Count, int CallerID, 
+				pHardyZCallback pCallbackHZ, pHardyZRangeCallback pCallbackRange,
+				pHardyZBallCallback pCallbackBall);
+static void	HardyZHandOut(struct hzChunk *chunk, uint64_t First, uint64_t Count, 
+				mpfr_t localT, mpfr_t Incr, struct HGT_BATCH *Batch);
+static void	HardyZTask(void * Arg);
+static int	HardyZPoint(struct computeHZ * comphz, bool Ball);
+static int	HardyZCore(struct computeHZ * comphz, mpfr_ptr Deriv, int Bits);
+static double	HardyZBound(struct computeHZ * comphz, uint64_t N, int Bits);
 
 // *******************************************************************
-// We compute the Hardy Z values here.  The loop is over the count of
-// different 't' values to compute (based on iCount). Inside the 
-// loop, we call ComputeSingleHardyZ. We then printf the result,
-// and then increase 't' by Incr and repeat iCount times.
+// We compute the Hardy Z values here, for 't', 't' + Incr, ... 
+// (Count values), passing each to pCallbackHZ in order.  See 
+// HardyZWithRange, which this calls.
 // *******************************************************************
 int HardyZWithCount(mpfr_t t, mpfr_t Incr, int Count, int CallerID, pHardyZCallback pCallbackHZ)
 {
-struct computeHZ 	comphz[HGT_THREADS_MAX];
+return(Count < 1 ? 1 : HardyZStream(t, Incr, (uint64_t) Count, CallerID, pCallbackHZ, NULL, NULL));
+}
+
+// *******************************************************************
+// As HardyZWithCount, but for any number of points (the callback is
+// given a 64-bit point number).  We hand out the points in chunks of 
+// HGT_STREAM_CHUNK, each a task for the library's worker pool, and 
+// the workers pass finished points through a result ring of up to 
+// HGT_RING_SIZE slots.  This (calling) thread is the ring's consumer:
+// it passes the results to the callback in order, and each time it 
+// has passed on a whole chunk, it hands out the chunk HGT_RING_SIZE 
+// points further on.  So the workers keep computing while the 
+// callback formats and writes results, and the memory we use does 
+// not depend on Count.  The calling thread may itself be a pool
+// worker (a pool task may call us); it then runs chunks while it
+// waits (see RingWait).
+// *******************************************************************
+int HardyZWithRange(mpfr_t t, mpfr_t Incr, uint64_t Count, int CallerID, 
+	pHardyZRangeCallback pCallbackRange)
+{
+return(Count < 1 ? 1 : HardyZStream(t, Incr, Count, CallerID, NULL, pCallbackRange, NULL));
+}
+
+// *******************************************************************
+// As HardyZWithRange, but the callback is also given the radius of
+// each value: Z(t) lies within Radius of the value passed.  The 
+// points (as for HardyZSingleBall) always use the MPFR code, so the 
+// radius is a proven bound (see HardyZBound) for t >= 
+// HGT_RS_BOUND_T_MIN, and infinite below.  A caller that needs the 
+// sign of Z(t) need only recompute the points for which HardyZBallSign
+// is 0.
+// *******************************************************************
+int HardyZWithBall(mpfr_t t, mpfr_t Incr, uint64_t Count, int CallerID, 
+	pHardyZBallCallback pCallbackBall)
+{
+return(Count < 1 ? 1 : HardyZStream(t, Incr, Count, CallerID, NULL, NULL, pCallbackBall));
+}
+
+// *******************************************************************
+// The sign of Z(t) given a value Z and radius: 1 or -1 if the ball 
+// around Z lies wholly on that side of zero, 0 if it contains zero.
+// *******************************************************************
+int HardyZBallSign(mpfr_t Z, double Radius)
+{
+if(mpfr_cmp_d (Z, Radius) > 0) {
+	return(1);
+	}
+if(mpfr_cmp_d (Z, -Radius) < 0) {
+	return(-1);
+	}
+return(0);
+}
+
+// -------------------------------------------------------------------
+// The code for HardyZWithCount, HardyZWithRange and HardyZWithBall.  
+// Exactly one of pCallbackHZ, pCallbackRange and pCallbackBall is not
+// NULL.
+// -------------------------------------------------------------------
+static int HardyZStream(mpfr_t t, mpfr_t Incr, uint64_t Count, int CallerID, 
+	pHardyZCallback pCallbackHZ, pHardyZRangeCallback pCallbackRange,
+	pHardyZBallCallback pCallbackBall)
+{
+struct computeHZ	*pts;
+struct hzChunk		*chunks;
+struct HGT_BATCH	*Batch;
+struct HGT_RING		*Ring;
 mpfr_t				localT;	// to avoid overwriting the passed 't'
-int					i;
+uint64_t			i, Size, k, c;
+uint64_t			Start = StatsStart(), Stage;	// see hgtStats.c
 
 // -------------------------------------------------------------------
-// Initialize several MPFR variables.
+// The ring holds Size points (a whole number of chunks).
 // -------------------------------------------------------------------
-for(i=0; i< hgt_init.MaxThreads; i++) { 
-	mpfr_inits2 (hgt_init.DefaultBits, comphz[i].t, comphz[i].Result, (mpfr_ptr) 0);
-	}
+Size = (Count + HGT_STREAM_CHUNK - 1) / HGT_STREAM_CHUNK * HGT_STREAM_CHUNK;
+Size = Size < HGT_RING_SIZE ? Size : HGT_RING_SIZE;
 mpfr_init2 (localT, hgt_init.DefaultBits);
 mpfr_set (localT, t, MPFR_RNDN);
+pts	   = malloc(Size * sizeof(struct computeHZ));
+chunks = malloc(Size / HGT_STREAM_CHUNK * sizeof(struct hzChunk));
+Ring   = RingCreate(Size);
+Batch  = PoolBatchCreate();
+for(i = 0; i < Size; i++) {
+	mpfr_inits2 (hgt_init.DefaultBits, pts[i].t, pts[i].Result, (mpfr_ptr) 0);
+	}
 
 // -------------------------------------------------------------------
-// We loop Count times, processing 't' in the first (i = 1) loop.
-// If Count is greater than one, we increment 't' by the Incr
-// amount and loop again.  
-//
-// In the loop, we manage threads (if requested) and call HardyZSingle 
-// (directly or indirectly) Count times.  We print the results using 
-// pCallbackHZ.
+// Hand out the first Size points.  The 't' values come from adding
+// Incr to 't' again and again, in order.
 // -------------------------------------------------------------------
-int			j, m, iRemaining;
-pthread_t	thread_id[HGT_THREADS_MAX];
+for(c = 0; c < Size / HGT_STREAM_CHUNK; c++)
+	{
+	chunks[c].pts  = &pts[c * HGT_STREAM_CHUNK];
+	chunks[c].Ring = Ring;
+	chunks[c].Ball = pCallbackBall != NULL;
+	if(c * HGT_STREAM_CHUNK < Count) {
+		HardyZHandOut(&chunks[c], c * HGT_STREAM_CHUNK, Count, localT, Incr, Batch);
+		}
+	}
 
-i = 0;
-while(i < Count)
+// -------------------------------------------------------------------
+// Pass on the results in order.  Once the last point of a chunk has
+// been passed on, the chunk's slots are free for the points Size
+// further on.
+// -------------------------------------------------------------------
+for(i = 0; i < Count; i++)
 	{
-	iRemaining = Count - i;
-	m = hgt_init.MaxThreads > iRemaining ? iRemaining : hgt_init.MaxThreads;
-	
-	for (j = 0; j < m; j++)
-		{
-		// ---------------------------------------------------------------
-		// Update comphz values for the current 't'
-		// ---------------------------------------------------------------	
-		mpfr_set (comphz[j].t, localT, MPFR_RNDN);
-		mpfr_set_ui (comphz[j].Result, 0, MPFR_RNDN);
-		
-		if(hgt_init.MaxThreads > 1) {
-			pthread_create( &thread_id[j], NULL, HardyZSingleThreaded, &comphz[j] );
-			}
-		else {
-			HardyZSingle(&comphz[0]); // if we arrive here, j = 0
-			}
-		mpfr_add (localT, localT, Incr, MPFR_RNDN);
+	k = i % Size;
+	Stage = StatsStart();
+	RingWait(Ring, i, Batch);
+	StatsStop(HGT_STAGE_IDLE, Stage);
+	Stage = StatsStart();
+	if(pCallbackBall != NULL) {
+		pCallbackBall(pts[k].t, pts[k].Result, pts[k].Radius, i, CallerID);
 		}
-	for (j = 0; j < m; j++)
-		{
-		if(hgt_init.MaxThreads > 1) {
-			pthread_join( thread_id[j], NULL); 
-			}
-		}		
-	for (j = 0; j < m; j++)
-		{	
-		pCallbackHZ(comphz[j].t, comphz[j].Result, i, CallerID);
-		i++;	// we need 'i' here so that it is incremented 'm' times 
-		}			
-	}	// end of outer for loop
+	else if(pCallbackRange != NULL) {
+		pCallbackRange(pts[k].t, pts[k].Result, i, CallerID);
+		}
+	else {
+		pCallbackHZ(pts[k].t, pts[k].Result, (int) i, CallerID);
+		}
+	StatsStop(HGT_STAGE_CALLBACK, Stage);
+	c = k / HGT_STREAM_CHUNK;
+	if((k + 1) % HGT_STREAM_CHUNK == 0 && chunks[c].Index + Size < Count) {
+		HardyZHandOut(&chunks[c], chunks[c].Index + Size, Count, localT, Incr, Batch);
+		}
+	}
+PoolWaitBatch(Batch);
 
 // -------------------------------------------------------------------
 // We are done.  Clear our local MPFR variables.
 // -------------------------------------------------------------------
-for(i=0; i< hgt_init.MaxThreads; i++) {
-	mpfr_clears (comphz[i].t, comphz[i].Result, (mpfr_ptr) 0);
+for(i = 0; i < Size; i++) {
+	mpfr_clears (pts[i].t, pts[i].Result, (mpfr_ptr) 0);
 	}
+PoolBatchFree(Batch);
+RingFree(Ring);
+free(chunks);
+free(pts);
 mpfr_clear(localT);
+StatsStop(HGT_STAGE_BATCH, Start);
 return(1);
 }
 
+// -------------------------------------------------------------------
+// Set up chunk for the points First, First + 1, ... (up to a chunk,
+// and not past Count), taking their 't' values from localT, and
+// submit it.
+// -------------------------------------------------------------------
+static void HardyZHandOut(struct hzChunk *chunk, uint64_t First, uint64_t Count, 
+	mpfr_t localT, mpfr_t Incr, struct HGT_BATCH *Batch)
+{
+int		j;
+
+chunk->Index = First;
+chunk->Count = Count - First < HGT_STREAM_CHUNK ? (int) (Count - First) : HGT_STREAM_CHUNK;
+for(j = 0; j < chunk->Count; j++) {
+	mpfr_set (chunk->pts[j].t, localT, MPFR_RNDN);
+	mpfr_set_ui (chunk->pts[j].Result, 0, MPFR_RNDN);
+	mpfr_add (localT, localT, Incr, MPFR_RNDN);
+	}
+PoolSubmit(Batch, HardyZTask, chunk);
+}
+
+// -------------------------------------------------------------------
+// The pool task: compute a chunk of points, publishing each to the 
+// ring as it is done.  Once the last point is published, the consumer
+// may hand the chunk out again, so we read it only before the loop.
+// -------------------------------------------------------------------
+static void HardyZTask(void * Arg)
+{
+struct hzChunk		*chunk = (struct hzChunk *) Arg;
+struct computeHZ	*pts = chunk->pts;
+struct HGT_RING		*Ring = chunk->Ring;
+uint64_t			Index = chunk->Index;
+int					Count = chunk->Count;
+bool				Ball = chunk->Ball;
+int					j;
+
+for(j = 0; j < Count; j++) {
+	HardyZPoint(&pts[j], Ball);
+	RingPublish(Ring, Index + j);
+	}
+}
+
 // *******************************************************************
 // For correct "C type" on the pthread_create call, we need this
 // pass-through function.
@@ -112,15 +245,85 @@ return(NULL);
 // 		comphz->t and comphz->ptrResult
 // and the following global variables:
 // 		hgt_init.my2Pi and hgt_init.DebugFlags
+// We also set comphz->Radius (see HardyZWithBall); it is infinite 
+// when a faster backend was used, as theirs is only an estimate.
 // *******************************************************************
 int HardyZSingle(struct computeHZ * comphz)
 {
-mpfr_t			tOver2Pi, T, N, P, Main, Remainder;
+return(HardyZPoint(comphz, false));
+}
+
+// *******************************************************************
+// As HardyZSingle, but with a proven radius: under SetAccuracyDigits
+// we use the MPFR code at the precision the digits need, never one of
+// the faster backends.
+// *******************************************************************
+int HardyZSingleBall(struct computeHZ * comphz)
+{
+return(HardyZPoint(comphz, true));
+}
+
+// -------------------------------------------------------------------
+// The code for HardyZSingle and HardyZSingleBall.
+// -------------------------------------------------------------------
+static int HardyZPoint(struct computeHZ * comphz, bool Ball)
+{
+uint64_t	Start = StatsStart();
+int			Backend = HGT_BACKEND_MPFR;
+int			Bits = hgt_init.DefaultBits;
+int			Result;
+
+// ---------------------------------------------------------------
+// If the caller asked for a fixed number of correct digits (see
+// SetAccuracyDigits), use the cheapest backend that gives them (MPFR
+// only, for a ball), and for MPFR, only the precision they need at 
+// this t.
+// ---------------------------------------------------------------
+if(hgt_init.AccuracyDigits > 0) {
+	Backend = Ball == true ? HGT_BACKEND_MPFR 
+		: SelectBackend(comphz->t, hgt_init.AccuracyDigits);
+	if(Backend != HGT_BACKEND_MPFR) {
+		comphz->Radius = INFINITY;
+		}
+	else {
+		Bits = SelectPrecision(comphz->t, hgt_init.AccuracyDigits);
+		}
+	}
+switch(Backend) {
+	case HGT_BACKEND_DOUBLE:	Result = HardyZ_Double(&comphz->Result, comphz->t);	break;
+	case HGT_BACKEND_DD:		Result = HardyZ_DD(&comphz->Result, comphz->t);		break;
+	case HGT_BACKEND_QUAD:		Result = HardyZ_Quad(&comphz->Result, comphz->t);	break;
+	default:					Result = HardyZCore(comphz, NULL, Bits);			break;
+	}
+StatsStop(HGT_STAGE_POINT, Start);
+StatsCount(HGT_STAT_POINTS, 1);
+return(Result);
+}
+
+// *******************************************************************
+// As HardyZSingle, but also compute Z'(t) (in Deriv), in the same 
+// pass through the main sum.  This always uses MPFR, at the full
+// precision.
+// *******************************************************************
+int HardyZSingleDeriv(struct computeHZ * comphz, mpfr_t Deriv)
+{
+return(HardyZCore(comphz, Deriv, hgt_init.DefaultBits));
+}
+
+// -------------------------------------------------------------------
+// The MPFR code for HardyZSingle and HardyZSingleDeriv, at Bits of
+// precision; Deriv may be NULL.
+// -------------------------------------------------------------------
+static int HardyZCore(struct computeHZ * comphz, mpfr_ptr Deriv, int Bits)
+{
+struct HGT_WORKMARK	Mark;
+mpfr_t			tOver2Pi, T, N, P, Main, Remainder, DMain, DRemainder;
 uint64_t		ui64N;
 bool			nEven;
 
-mpfr_inits2 (hgt_init.DefaultBits,  
-				tOver2Pi, T, N, P, Main, Remainder, (mpfr_ptr) 0);
+Mark = WorkMark();
+WorkInits(Bits,  
+				tOver2Pi, T, N, P, Main, Remainder, DMain, DRemainder, (mpfr_ptr) 0);
 
 // ---------------------------------------------------------------
 // Compute N and P for the given 't'. 
@@ -139,18 +342,53 @@ nEven = (ui64N % 2 == 0) ? true : false;
 // ---------------------------------------------------------------
 // Compute the remainder term.
 // ---------------------------------------------------------------		
-RS_Remainder(&Remainder, tOver2Pi, nEven, P, hgt_init.DefaultBits);
+if(Deriv == NULL) {
+	RS_Remainder(&Remainder, tOver2Pi, nEven, P, Bits);
+	}
+else {
+	RS_RemainderDeriv(&Remainder, &DRemainder, tOver2Pi, nEven, P, Bits);
+	}
 	
 // ---------------------------------------------------------------
 // Now compute the Main term and add to Remainder to get HardyZ.
 // ---------------------------------------------------------------	
-RS_MainTerm(&Main, comphz->t, ui64N, hgt_init.DefaultBits);
+if(Deriv == NULL) {
+	RS_MainTerm(&Main, comphz->t, ui64N, Bits);
+	}
+else {
+	RS_MainTermDeriv(&Main, &DMain, comphz->t, ui64N, Bits);
+	mpfr_add (Deriv, DMain, DRemainder, MPFR_RNDN);
+	}
 mpfr_add (comphz->Result, Main, Remainder, MPFR_RNDN);
+comphz->Radius = HardyZBound(comphz, ui64N, Bits);
 
 // -------------------------------------------------------------------
 // Clear our local MPFR variables.
 // -------------------------------------------------------------------
-mpfr_clears (tOver2Pi, T, N, P, Main, Remainder, (mpfr_ptr) 0);
+WorkRelease(Mark);
 return(1);
 }
 
+// -------------------------------------------------------------------
+// A bound on |comphz->Result - Z(t)| for the MPFR code at Bits, with N
+// terms in the main sum: the bounds on the main term and the 
+// remainder (see RS_MainTermBound and RS_RemainderBound), Gabcke's 
+// bound |R_4(t)| <= 0.017 t^{-11/4} (for t >= 200) on what the C0..C4
+// terms leave out, and the rounding of the final sum.  The bound is 
+// formed in double precision, so we allow a little extra for that.
+// -------------------------------------------------------------------
+static double HardyZBound(struct computeHZ * comphz, uint64_t N, int Bits)
+{
+double	dt = mpfr_get_d (comphz->t, MPFR_RNDU);
+double	Bound;
+int		ResultBits = (int) mpfr_get_prec (comphz->Result);
+
+if(dt < HGT_RS_BOUND_T_MIN || mpfr_number_p (comphz->Result) == 0) {
+	return(INFINITY);
+	}
+Bound = RS_MainTermBound(dt, N, Bits) + RS_RemainderBound(dt / (2.0 * M_PI), Bits)
+	+ HGT_RS_BOUND_D4 * pow(dt, -2.75)
+	+ fabs(mpfr_get_d (comphz->Result, MPFR_RNDA)) 
+		* ldexp(1.0, -(ResultBits < Bits ? ResultBits : Bits));
+return(Bound * (1.0 + 1e-6));
+}
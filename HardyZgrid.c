@@ -0,0 +1,701 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file implements an Odlyzko-Schonhage style multi-evaluation
+// engine for a dense grid of 't' values.  Write the main term of the
+// Riemann-Siegel formula as
+//
+//		Main(t) = 2 * Re[ e^{i theta(t)} F(t) ],
+//		F(t)	= SUM_{n=1}^{N} n^{-1/2} e^{-i t log n}.
+//
+// For a "window" of grid points sharing the same N, we pick a center
+// tc and write t = tc + tau.  F is then a band-limited function of
+// tau (frequencies log n lie in [0, log N]), so we:
+//
+// (1) evaluate F on a coarse grid tau_j = j * Delta with one pass over
+//	   n = 1..N.  The log n values are grouped into K-term Taylor blocks
+//	   whose centers are equally spaced, which turns the coarse grid
+//	   values into K discrete Fourier transforms (done by FFT);
+// (2) recover F at each requested point by Gaussian-regularized
+//	   band-limited (sinc) interpolation from the coarse grid.
+//
+// The theta(t) and remainder terms are still computed per point using
+// ThetaOfT and RS_Remainder.  The amortized cost per point is about
+// K log C + J multiplies (C = FFT size, J = interpolation half width),
+// instead of the N log and cos evaluations done by RS_MainTerm.  The
+// FFTs and the per-point work run on the library's worker pool.
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+// A complex number as a pair of mpfr_t values.
+// -------------------------------------------------------------------
+struct gridCmplx {
+	mpfr_t		re;
+	mpfr_t		im;
+};
+
+// -------------------------------------------------------------------
+// All data needed to process one window of grid points.
+// -------------------------------------------------------------------
+struct gridWindow {
+	uint64_t			N;			// number of main sum terms
+	int					Count;		// number of grid points in window
+	int					Bits;		// working precision (guard bits added)
+	unsigned int		C;			// FFT size (power of 2)
+	int					K;			// Taylor terms per block
+	int					J;			// interpolation half width
+	long				jLow;		// first coarse grid index used
+	long				jHigh;		// last coarse grid index used
+	mpfr_t				tc;			// window center
+	mpfr_t				Delta;		// coarse grid spacing
+	mpfr_t				LogMid;		// (log N) / 2
+	mpfr_t				Alpha;		// Gaussian regularization constant
+	struct gridCmplx	*Coarse;	// F(tc + j Delta) e^{i j Delta LogMid}
+};
+
+// -------------------------------------------------------------------
+// Pool tasks: one requested point, or one FFT of block moments.
+// -------------------------------------------------------------------
+struct gridItem {
+	struct computeHZ	comphz;
+	struct gridWindow	*gw;		// NULL: compute with HardyZSingle
+	struct HGT_BATCH	*Batch;
+	int					Done;
+};
+
+struct gridFFTTask {
+	struct gridCmplx	*a;
+	struct gridCmplx	*w;
+	unsigned int		C;
+	int					Bits;
+};
+
+static void	GridPointTask(void *Arg);
+static void	GridFFTTask(void *Arg);
+static void	GridCmplxInit(struct gridCmplx *z, int iFloatBits);
+static void	GridCmplxClear(struct gridCmplx *z);
+static int	GridWindowSize(struct gridWindow *gw, mpfr_t t, mpfr_t Incr, int Remaining);
+static bool	GridWindowIsWorthIt(struct gridWindow *gw);
+static int	GridCoarseValues(struct gridWindow *gw);
+static int	GridFFT(struct gridCmplx *a, struct gridCmplx *w, unsigned int C, mpfr_t Temp1, mpfr_t Temp2);
+static int	GridInterpolate(struct gridWindow *gw, mpfr_t *Result, mpfr_t t);
+
+// *******************************************************************
+// We compute the Hardy Z values for the grid t, t + Incr, ...,
+// t + (Count - 1) * Incr, and report each one through pCallbackRange,
+// in the same way (and the same order) as HardyZWithRange.  Each
+// window of points sharing the same N is either done with the 
+// multi-evaluation engine or, if that would not save time, one point
+// at a time.  A window holds at most HGT_GRID_WINDOW points, so the
+// memory we use does not depend on Count.
+// *******************************************************************
+int HardyZWithGrid(mpfr_t t, mpfr_t Incr, uint64_t Count, int CallerID, 
+	pHardyZRangeCallback pCallbackRange)
+{
+struct gridWindow	gw;
+struct gridItem		*items;
+struct HGT_BATCH	*Batch;
+mpfr_t				localT;	// to avoid overwriting the passed 't'
+uint64_t			Done = 0;
+int					i, j, Size;
+
+if(Count < 1) {
+	return(1);
+	}
+mpfr_init2 (localT, hgt_init.DefaultBits);
+mpfr_set (localT, t, MPFR_RNDN);
+Batch = PoolBatchCreate();
+
+Size  = Count < HGT_GRID_WINDOW ? (int) Count : HGT_GRID_WINDOW;
+items = malloc(Size * sizeof(struct gridItem));
+for(i = 0; i < Size; i++) {
+	mpfr_inits2 (hgt_init.DefaultBits, items[i].comphz.t, items[i].comphz.Result, (mpfr_ptr) 0);
+	items[i].Batch	= Batch;
+	}
+
+while(Done < Count)
+	{
+	// ---------------------------------------------------------------
+	// Size the next window, which starts at localT.
+	// ---------------------------------------------------------------
+	mpfr_inits2 (hgt_init.DefaultBits + HGT_GRID_GUARD_BITS,
+		gw.tc, gw.Delta, gw.LogMid, gw.Alpha, (mpfr_ptr) 0);
+	GridWindowSize(&gw, localT, Incr, 
+		Count - Done < (uint64_t) Size ? (int) (Count - Done) : Size);
+
+	// ---------------------------------------------------------------
+	// The 't' values are generated exactly as in HardyZWithRange (by
+	// repeated addition of Incr), so that both functions report the
+	// same 't' values.
+	// ---------------------------------------------------------------
+	for(i = 0; i < gw.Count; i++) {
+		mpfr_set (items[i].comphz.t, localT, MPFR_RNDN);
+		mpfr_add (localT, localT, Incr, MPFR_RNDN);
+		items[i].Done = 0;
+		}
+
+	if(GridWindowIsWorthIt(&gw) == true) {
+		// -----------------------------------------------------------
+		// The window center is halfway between its first and last
+		// points.  Build the coarse grid, then interpolate each point.
+		// -----------------------------------------------------------
+		mpfr_add (gw.tc, items[0].comphz.t, items[gw.Count - 1].comphz.t, MPFR_RNDN);
+		mpfr_div_2ui (gw.tc, gw.tc, 1, MPFR_RNDN);
+		GridCoarseValues(&gw);
+		for(i = 0; i < gw.Count; i++) {
+			items[i].gw = &gw;
+			}
+		}
+	else {
+		for(i = 0; i < gw.Count; i++) {
+			items[i].gw = NULL;
+			}
+		}
+
+	// ---------------------------------------------------------------
+	// Hand the points to the pool and report them in order.
+	// ---------------------------------------------------------------
+	for(i = 0; i < gw.Count; i++) {
+		PoolSubmit(Batch, GridPointTask, &items[i]);
+		}
+	for(i = 0; i < gw.Count; i++) {
+		PoolWaitItem(Batch, &items[i].Done);
+		pCallbackRange(items[i].comphz.t, items[i].comphz.Result, Done + i, CallerID);
+		}
+	PoolWaitBatch(Batch);
+
+	if(items[0].gw != NULL) {
+		for(j = 0; j <= gw.jHigh - gw.jLow; j++) {
+			GridCmplxClear(&gw.Coarse[j]);
+			}
+		free(gw.Coarse);
+		}
+	Done += gw.Count;
+	mpfr_clears (gw.tc, gw.Delta, gw.LogMid, gw.Alpha, (mpfr_ptr) 0);
+	}
+
+// -------------------------------------------------------------------
+// We are done.  Clear our local MPFR variables.
+// -------------------------------------------------------------------
+for(i = 0; i < Size; i++) {
+	mpfr_clears (items[i].comphz.t, items[i].comphz.Result, (mpfr_ptr) 0);
+	}
+free(items);
+PoolBatchFree(Batch);
+mpfr_clear(localT);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// The pool task for one requested point.
+// -------------------------------------------------------------------
+static void GridPointTask(void *Arg)
+{
+struct gridItem	*item = (struct gridItem *) Arg;
+
+if(item->gw != NULL) {
+	GridInterpolate(item->gw, &item->comphz.Result, item->comphz.t);
+	}
+else {
+	HardyZSingle(&item->comphz);
+	}
+PoolItemDone(item->Batch, &item->Done);
+}
+
+// -------------------------------------------------------------------
+// The pool task for the FFT of one set of block moments.
+// -------------------------------------------------------------------
+static void GridFFTTask(void *Arg)
+{
+struct gridFFTTask	*task = (struct gridFFTTask *) Arg;
+mpfr_t				Temp1, Temp2;
+
+mpfr_inits2 (task->Bits, Temp1, Temp2, (mpfr_ptr) 0);
+GridFFT(task->a, task->w, task->C, Temp1, Temp2);
+mpfr_clears (Temp1, Temp2, (mpfr_ptr) 0);
+}
+
+// -------------------------------------------------------------------
+// Initialize or clear a complex (pair of mpfr_t) value.
+// -------------------------------------------------------------------
+static void GridCmplxInit(struct gridCmplx *z, int iFloatBits)
+{
+mpfr_inits2 (iFloatBits, z->re, z->im, (mpfr_ptr) 0);
+mpfr_set_zero (z->re, 1);
+mpfr_set_zero (z->im, 1);
+}
+
+static void GridCmplxClear(struct gridCmplx *z)
+{
+mpfr_clears (z->re, z->im, (mpfr_ptr) 0);
+}
+
+// -------------------------------------------------------------------
+// We determine the window that starts at 't': its N, the number of
+// grid points it holds, and the sizes (C, K, J) of the coarse grid.
+// A window holds only points with the same N = floor(sqrt(t / 2 pi)),
+// and is limited so that the FFT size does not exceed HGT_GRID_FFT_MAX.
+// -------------------------------------------------------------------
+static int GridWindowSize(struct gridWindow *gw, mpfr_t t, mpfr_t Incr, int Remaining)
+{
+mpfr_t		Temp1, Temp2;
+double		Alpha, dIncr, Rho, LnTerm, LnTarget;
+long		Span, jMax;
+int			Count;
+
+gw->Bits = hgt_init.DefaultBits + HGT_GRID_GUARD_BITS;
+mpfr_inits2 (gw->Bits, Temp1, Temp2, (mpfr_ptr) 0);
+
+// -------------------------------------------------------------------
+// N for the first point; then the number of points that share it,
+// using N changes at t = 2 pi (N + 1)^2.
+// -------------------------------------------------------------------
+mpfr_div (Temp1, t, hgt_init.my2Pi, MPFR_RNDN);
+mpfr_sqrt (Temp1, Temp1, MPFR_RNDN);
+mpfr_floor (Temp1, Temp1);
+gw->N = mpfr_get_uj (Temp1, MPFR_RNDN);
+
+mpfr_add_ui (Temp1, Temp1, 1, MPFR_RNDN);
+mpfr_sqr (Temp1, Temp1, MPFR_RNDN);
+mpfr_mul (Temp1, Temp1, hgt_init.my2Pi, MPFR_RNDN);
+mpfr_sub (Temp1, Temp1, t, MPFR_RNDN);
+mpfr_div (Temp1, Temp1, Incr, MPFR_RNDN);
+mpfr_ceil (Temp1, Temp1);
+if(mpfr_cmp_si (Temp1, Remaining) >= 0) {
+	Count = Remaining;
+	}
+else {
+	Count = mpfr_get_si (Temp1, MPFR_RNDN);
+	Count = Count < 1 ? 1 : Count;
+	}
+gw->Count = Count;
+gw->C = 0;
+gw->K = 0;
+gw->J = 0;
+if(gw->N < 2) {
+	mpfr_clears (Temp1, Temp2, (mpfr_ptr) 0);
+	return(1);
+	}
+
+// -------------------------------------------------------------------
+// Coarse grid spacing.  With sigma = (log N) / 2 the half bandwidth
+// of F after centering, we sample at Delta = pi / (beta * sigma),
+// with beta = HGT_GRID_OVERSAMPLE.
+// -------------------------------------------------------------------
+mpfr_log_ui (gw->LogMid, gw->N, MPFR_RNDN);
+mpfr_div_2ui (gw->LogMid, gw->LogMid, 1, MPFR_RNDN);
+mpfr_mul_ui (Temp2, gw->LogMid, HGT_GRID_OVERSAMPLE, MPFR_RNDN);
+mpfr_div (gw->Delta, hgt_init.myPi, Temp2, MPFR_RNDN);
+
+// -------------------------------------------------------------------
+// Interpolation half width J.  For sample spacing Delta and half
+// bandwidth sigma, let Alpha = (pi - Delta * sigma) / 2.  Truncating
+// the Gaussian-regularized sinc series to |x - j| <= J, the error is
+// at most 2 M e^{-Alpha J} / sqrt(pi Alpha J), with M <= 2 sqrt(N).
+// -------------------------------------------------------------------
+Alpha	= (M_PI - (M_PI / HGT_GRID_OVERSAMPLE)) / 2.0;
+mpfr_set_d (gw->Alpha, Alpha, MPFR_RNDN);
+LnTarget = (double) gw->Bits * M_LN2;
+gw->J	= (int) ceil((LnTarget + log(4.0 * sqrt((double) gw->N))) / Alpha);
+
+// -------------------------------------------------------------------
+// Limit the window so that the coarse grid (all points, plus J on
+// each side) fits in one quarter of the largest FFT.  The Taylor
+// blocks then converge with Rho <= pi / 4.
+// -------------------------------------------------------------------
+dIncr	= mpfr_get_d (Incr, MPFR_RNDN) / mpfr_get_d (gw->Delta, MPFR_RNDN);
+Span	= (HGT_GRID_FFT_MAX / 4) - gw->J - 2;
+if(Span < 1 || (double) (gw->Count - 1) * dIncr > 2.0 * Span) {
+	gw->Count = Span < 1 ? 1 : (int) floor(2.0 * Span / dIncr) + 1;
+	gw->Count = gw->Count > Count ? Count : gw->Count;
+	}
+jMax	= (long) ceil((double) (gw->Count - 1) * dIncr / 2.0) + gw->J + 2;
+gw->jLow	= -jMax;
+gw->jHigh	= jMax;
+for(gw->C = 4; gw->C < 4 * jMax; gw->C *= 2)
+	;
+
+// -------------------------------------------------------------------
+// Taylor terms K per block: each block has |tau * delta| <= Rho, so
+// we need 4 sqrt(N) Rho^K / K! below 2^{-Bits}.  (Logs avoid underflow.)
+// -------------------------------------------------------------------
+Rho		= M_PI * (double) jMax / (double) gw->C;
+LnTerm	= log(8.0 * sqrt((double) gw->N));
+for(gw->K = 1; LnTerm > -LnTarget; gw->K++) {
+	LnTerm += log(Rho / (double) gw->K);
+	}
+mpfr_clears (Temp1, Temp2, (mpfr_ptr) 0);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// We compare (in rough multiply counts) the cost of doing a window
+// one point at a time against the cost of the multi-evaluation engine.
+// -------------------------------------------------------------------
+static bool GridWindowIsWorthIt(struct gridWindow *gw)
+{
+double		Direct, Grid, LogC, Coarse;
+
+if(gw->N < HGT_GRID_MIN_N || gw->Count < 2 || gw->C == 0) {
+	return(false);
+	}
+LogC	= log2((double) gw->C);
+Coarse	= (double) (gw->jHigh - gw->jLow + 1);
+Direct	= (double) gw->Count * (double) gw->N * HGT_GRID_COST_TERM;
+Grid	= (double) gw->N * (2.0 * gw->K + HGT_GRID_COST_TERM)
+		+ (double) gw->K * (2.0 * gw->C * LogC + 2.0 * Coarse)
+		+ (double) gw->Count * 6.0 * gw->J;
+return(Grid < Direct ? true : false);
+}
+
+// -------------------------------------------------------------------
+// We compute the centered coarse grid values
+//		Coarse[j] = F(tc + j Delta) e^{i j Delta LogMid},  jLow <= j <= jHigh.
+//
+// Write log n = LogMid + 2 w b + delta, with w = pi / (C Delta), b an
+// integer and |delta| <= w.  Then with tau_j = j Delta,
+//		e^{-i tau_j log n} = e^{-i tau_j LogMid} e^{-2 pi i j b / C}
+//			* SUM_k (-i)^k (tau_j w)^k (delta / w)^k / k!
+// so that
+//		Coarse[j] = SUM_k [(j pi / C)^k / k!] * DFT_b(Moment[k][b])(j),
+//		Moment[k][b] = (-i)^k SUM_{n in block b} a_n (delta_n / w)^k,
+// with a_n = n^{-1/2} e^{-i tc log n}.
+// -------------------------------------------------------------------
+static int GridCoarseValues(struct gridWindow *gw)
+{
+struct gridCmplx	**Moment, *Twiddle, Term;
+struct gridFFTTask	*FFTTasks;
+struct HGT_BATCH	*Batch;
+mpfr_t				LogN, TwoW, u, Phase, Sin, Cos, RecipSqrtn, Temp1, Temp2;
+mpfr_t				*cPow, v;
+uint64_t			n;
+unsigned int		bin;
+long				b, j, nCoarse;
+int					k;
+
+// -------------------------------------------------------------------
+// Initialize the MPFR variables.
+// -------------------------------------------------------------------
+mpfr_inits2 (gw->Bits, LogN, TwoW, u, Phase, Sin, Cos, RecipSqrtn,
+	Temp1, Temp2, v, (mpfr_ptr) 0);
+GridCmplxInit(&Term, gw->Bits);
+
+nCoarse = gw->jHigh - gw->jLow + 1;
+gw->Coarse = malloc(nCoarse * sizeof(struct gridCmplx));
+cPow = malloc(nCoarse * sizeof(mpfr_t));
+for(j = 0; j < nCoarse; j++) {
+	GridCmplxInit(&gw->Coarse[j], gw->Bits);
+	mpfr_init2 (cPow[j], gw->Bits);
+	mpfr_set_ui (cPow[j], 1, MPFR_RNDN);
+	}
+Moment = malloc(gw->K * sizeof(struct gridCmplx *));
+for(k = 0; k < gw->K; k++) {
+	Moment[k] = malloc(gw->C * sizeof(struct gridCmplx));
+	for(bin = 0; bin < gw->C; bin++) {
+		GridCmplxInit(&Moment[k][bin], gw->Bits);
+		}
+	}
+
+// -------------------------------------------------------------------
+// The FFT twiddle factors e^{-2 pi i k / C}, k < C/2.
+// -------------------------------------------------------------------
+Twiddle = malloc((gw->C / 2) * sizeof(struct gridCmplx));
+for(bin = 0; bin < gw->C / 2; bin++) {
+	GridCmplxInit(&Twiddle[bin], gw->Bits);
+	mpfr_mul_ui (Temp1, hgt_init.my2Pi, bin, MPFR_RNDN);
+	mpfr_div_ui (Temp1, Temp1, gw->C, MPFR_RNDN);
+	mpfr_sin_cos (Twiddle[bin].im, Twiddle[bin].re, Temp1, MPFR_RNDN);
+	mpfr_neg (Twiddle[bin].im, Twiddle[bin].im, MPFR_RNDN);
+	}
+
+// -------------------------------------------------------------------
+// One pass over n = 1 to N accumulates all of the block moments.
+// -------------------------------------------------------------------
+mpfr_mul_ui (TwoW, gw->Delta, gw->C, MPFR_RNDN);
+mpfr_div (TwoW, hgt_init.my2Pi, TwoW, MPFR_RNDN);		// 2 w
+
+for(n = 1; n <= gw->N; n++) {
+	// ---------------------------------------------------------------
+	// Block number b and the scaled offset u = delta / w in [-1, 1].
+	// ---------------------------------------------------------------
+	mpfr_set_uj (Temp1, n, MPFR_RNDN);
+	mpfr_log (LogN, Temp1, MPFR_RNDN);
+	mpfr_rec_sqrt (RecipSqrtn, Temp1, MPFR_RNDN);
+	mpfr_sub (u, LogN, gw->LogMid, MPFR_RNDN);
+	mpfr_div (u, u, TwoW, MPFR_RNDN);
+	b = mpfr_get_si (u, MPFR_RNDN);
+	mpfr_sub_si (u, u, b, MPFR_RNDN);
+	mpfr_mul_2ui (u, u, 1, MPFR_RNDN);
+	bin = (unsigned int) (((b % (long) gw->C) + (long) gw->C) % (long) gw->C);
+
+	// ---------------------------------------------------------------
+	// a_n = n^{-1/2} [cos(tc log n) - i sin(tc log n)]
+	// ---------------------------------------------------------------
+	mpfr_mul (Phase, gw->tc, LogN, MPFR_RNDN);
+	mpfr_sin_cos (Sin, Cos, Phase, MPFR_RNDN);
+	mpfr_mul (Term.re, RecipSqrtn, Cos, MPFR_RNDN);
+	mpfr_mul (Term.im, RecipSqrtn, Sin, MPFR_RNDN);
+	mpfr_neg (Term.im, Term.im, MPFR_RNDN);
+
+	// ---------------------------------------------------------------
+	// Add (-i)^k a_n u^k to Moment[k][bin] for each k.
+	// ---------------------------------------------------------------
+	for(k = 0; k < gw->K; k++) {
+		switch(k % 4) {
+			case 0:
+				mpfr_add (Moment[k][bin].re, Moment[k][bin].re, Term.re, MPFR_RNDN);
+				mpfr_add (Moment[k][bin].im, Moment[k][bin].im, Term.im, MPFR_RNDN);
+				break;
+			case 1:
+				mpfr_add (Moment[k][bin].re, Moment[k][bin].re, Term.im, MPFR_RNDN);
+				mpfr_sub (Moment[k][bin].im, Moment[k][bin].im, Term.re, MPFR_RNDN);
+				break;
+			case 2:
+				mpfr_sub (Moment[k][bin].re, Moment[k][bin].re, Term.re, MPFR_RNDN);
+				mpfr_sub (Moment[k][bin].im, Moment[k][bin].im, Term.im, MPFR_RNDN);
+				break;
+			default:
+				mpfr_sub (Moment[k][bin].re, Moment[k][bin].re, Term.im, MPFR_RNDN);
+				mpfr_add (Moment[k][bin].im, Moment[k][bin].im, Term.re, MPFR_RNDN);
+				break;
+			}
+		mpfr_mul (Term.re, Term.re, u, MPFR_RNDN);
+		mpfr_mul (Term.im, Term.im, u, MPFR_RNDN);
+		}
+	} // end of for loop
+
+// -------------------------------------------------------------------
+// The K transforms are independent, so they run on the worker pool.
+// -------------------------------------------------------------------
+FFTTasks = malloc(gw->K * sizeof(struct gridFFTTask));
+Batch = PoolBatchCreate();
+for(k = 0; k < gw->K; k++) {
+	FFTTasks[k].a		= Moment[k];
+	FFTTasks[k].w		= Twiddle;
+	FFTTasks[k].C		= gw->C;
+	FFTTasks[k].Bits	= gw->Bits;
+	PoolSubmit(Batch, GridFFTTask, &FFTTasks[k]);
+	}
+PoolWaitBatch(Batch);
+PoolBatchFree(Batch);
+free(FFTTasks);
+
+// -------------------------------------------------------------------
+// For each k, add (j pi / C)^k / k! times the transformed moments
+// into the coarse grid values.
+// -------------------------------------------------------------------
+for(k = 0; k < gw->K; k++) {
+	for(j = 0; j < nCoarse; j++) {
+		bin = (unsigned int) (((gw->jLow + j) % (long) gw->C + (long) gw->C) % (long) gw->C);
+		mpfr_fma (gw->Coarse[j].re, cPow[j], Moment[k][bin].re, gw->Coarse[j].re, MPFR_RNDN);
+		mpfr_fma (gw->Coarse[j].im, cPow[j], Moment[k][bin].im, gw->Coarse[j].im, MPFR_RNDN);
+		// cPow[j] = (j pi / C)^{k+1} / (k+1)!
+		mpfr_mul_si (v, hgt_init.myPi, gw->jLow + j, MPFR_RNDN);
+		mpfr_div_ui (v, v, gw->C * (unsigned long) (k + 1), MPFR_RNDN);
+		mpfr_mul (cPow[j], cPow[j], v, MPFR_RNDN);
+		}
+	for(bin = 0; bin < gw->C; bin++) {
+		GridCmplxClear(&Moment[k][bin]);
+		}
+	free(Moment[k]);
+	}
+
+// -------------------------------------------------------------------
+// Free the space used by the local mpfr variables.
+// -------------------------------------------------------------------
+for(bin = 0; bin < gw->C / 2; bin++) {
+	GridCmplxClear(&Twiddle[bin]);
+	}
+for(j = 0; j < nCoarse; j++) {
+	mpfr_clear (cPow[j]);
+	}
+free(Twiddle);
+free(Moment);
+free(cPow);
+GridCmplxClear(&Term);
+mpfr_clears (LogN, TwoW, u, Phase, Sin, Cos, RecipSqrtn,
+	Temp1, Temp2, v, (mpfr_ptr) 0);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// In-place forward DFT of length C (a power of 2):
+//		a[j] <- SUM_b a[b] e^{-2 pi i j b / C}
+// using the iterative radix-2 algorithm.  The passed twiddle factors
+// are w[k] = e^{-2 pi i k / C} for k < C/2.
+// -------------------------------------------------------------------
+static int GridFFT(struct gridCmplx *a, struct gridCmplx *w, unsigned int C, mpfr_t Temp1, mpfr_t Temp2)
+{
+unsigned int	i, j, k, Len, Half, Step, Bit;
+
+// -------------------------------------------------------------------
+// Bit reversal permutation (mpfr_swap only exchanges pointers).
+// -------------------------------------------------------------------
+for(i = 1, j = 0; i < C; i++) {
+	for(Bit = C >> 1; j & Bit; Bit >>= 1) {
+		j ^= Bit;
+		}
+	j ^= Bit;
+	if(i < j) {
+		mpfr_swap (a[i].re, a[j].re);
+		mpfr_swap (a[i].im, a[j].im);
+		}
+	}
+
+// -------------------------------------------------------------------
+// Butterflies: (u, v) -> (u + w v, u - w v).
+// -------------------------------------------------------------------
+for(Len = 2; Len <= C; Len <<= 1) {
+	Half = Len >> 1;
+	Step = C / Len;
+	for(i = 0; i < C; i += Len) {
+		for(k = 0; k < Half; k++) {
+			struct gridCmplx	*u = &a[i + k];
+			struct gridCmplx	*v = &a[i + k + Half];
+			struct gridCmplx	*tw = &w[k * Step];
+
+			mpfr_fmms (Temp1, v->re, tw->re, v->im, tw->im, MPFR_RNDN);
+			mpfr_fmma (Temp2, v->re, tw->im, v->im, tw->re, MPFR_RNDN);
+			mpfr_sub (v->re, u->re, Temp1, MPFR_RNDN);
+			mpfr_sub (v->im, u->im, Temp2, MPFR_RNDN);
+			mpfr_add (u->re, u->re, Temp1, MPFR_RNDN);
+			mpfr_add (u->im, u->im, Temp2, MPFR_RNDN);
+			}
+		}
+	}
+return(1);
+}
+
+// -------------------------------------------------------------------
+// We compute Z(t) for one point of the window.  With x = (t - tc) / Delta,
+// the centered value G(x) = F(t) e^{i (t - tc) LogMid} is
+//
+//	G(x) = [sin(pi x) / pi] SUM_{|x - j| <= J} (-1)^j Coarse[j]
+//				* exp(-Alpha (x - j)^2 / J) / (x - j),
+//
+// and the main term is 2 Re[e^{i (theta(t) - (t - tc) LogMid)} G(x)].
+// The Gaussian weights are updated by ratios, so the loop over j has
+// no exp calls.
+// -------------------------------------------------------------------
+static int GridInterpolate(struct gridWindow *gw, mpfr_t *Result, mpfr_t t)
+{
+mpfr_t		tau, x, d, Gauss, Ratio, RatioStep, Weight, SumRe, SumIm;
+mpfr_t		Theta, Phase, Sin, Cos, Temp1, tOver2Pi, T, N, P, Remainder;
+long		j, jFirst, jLast, jx;
+uint64_t	ui64N;
+bool		nEven;
+
+mpfr_inits2 (gw->Bits, tau, x, d, Gauss, Ratio, RatioStep, Weight,
+	SumRe, SumIm, Theta, Phase, Sin, Cos, Temp1, (mpfr_ptr) 0);
+mpfr_inits2 (hgt_init.DefaultBits, tOver2Pi, T, N, P, Remainder, (mpfr_ptr) 0);
+
+mpfr_sub (tau, t, gw->tc, MPFR_RNDN);
+mpfr_div (x, tau, gw->Delta, MPFR_RNDN);
+
+if(mpfr_integer_p (x)) {
+	// ---------------------------------------------------------------
+	// A point exactly on the coarse grid needs no interpolation.
+	// ---------------------------------------------------------------
+	jx = mpfr_get_si (x, MPFR_RNDN);
+	mpfr_set (SumRe, gw->Coarse[jx - gw->jLow].re, MPFR_RNDN);
+	mpfr_set (SumIm, gw->Coarse[jx - gw->jLow].im, MPFR_RNDN);
+	}
+else {
+	mpfr_set_zero (SumRe, 1);
+	mpfr_set_zero (SumIm, 1);
+
+	// ---------------------------------------------------------------
+	// First sample: d = x - jFirst (at most J).  Gauss = e^{-A d^2 / J},
+	// and Ratio = e^{A (2d - 1) / J} moves Gauss from d to d - 1.
+	// ---------------------------------------------------------------
+	mpfr_sub_ui (Temp1, x, gw->J, MPFR_RNDN);
+	mpfr_ceil (Temp1, Temp1);
+	jFirst	= mpfr_get_si (Temp1, MPFR_RNDN);
+	mpfr_add_ui (Temp1, x, gw->J, MPFR_RNDN);
+	mpfr_floor (Temp1, Temp1);
+	jLast	= mpfr_get_si (Temp1, MPFR_RNDN);
+
+	mpfr_sub_si (d, x, jFirst, MPFR_RNDN);
+	mpfr_sqr (Temp1, d, MPFR_RNDN);
+	mpfr_mul (Temp1, Temp1, gw->Alpha, MPFR_RNDN);
+	mpfr_div_ui (Temp1, Temp1, gw->J, MPFR_RNDN);
+	mpfr_neg (Temp1, Temp1, MPFR_RNDN);
+	mpfr_exp (Gauss, Temp1, MPFR_RNDN);
+
+	mpfr_mul_2ui (Temp1, d, 1, MPFR_RNDN);
+	mpfr_sub_ui (Temp1, Temp1, 1, MPFR_RNDN);
+	mpfr_mul (Temp1, Temp1, gw->Alpha, MPFR_RNDN);
+	mpfr_div_ui (Temp1, Temp1, gw->J, MPFR_RNDN);
+	mpfr_exp (Ratio, Temp1, MPFR_RNDN);
+
+	mpfr_mul_2ui (Temp1, gw->Alpha, 1, MPFR_RNDN);
+	mpfr_div_ui (Temp1, Temp1, gw->J, MPFR_RNDN);
+	mpfr_neg (Temp1, Temp1, MPFR_RNDN);
+	mpfr_exp (RatioStep, Temp1, MPFR_RNDN);
+
+	for(j = jFirst; j <= jLast; j++) {
+		mpfr_div (Weight, Gauss, d, MPFR_RNDN);
+		if(j % 2 != 0) {
+			mpfr_neg (Weight, Weight, MPFR_RNDN);
+			}
+		mpfr_fma (SumRe, Weight, gw->Coarse[j - gw->jLow].re, SumRe, MPFR_RNDN);
+		mpfr_fma (SumIm, Weight, gw->Coarse[j - gw->jLow].im, SumIm, MPFR_RNDN);
+
+		mpfr_sub_ui (d, d, 1, MPFR_RNDN);
+		mpfr_mul (Gauss, Gauss, Ratio, MPFR_RNDN);
+		mpfr_mul (Ratio, Ratio, RatioStep, MPFR_RNDN);
+		}
+
+	// ---------------------------------------------------------------
+	// Multiply by sin(pi x) / pi.
+	// ---------------------------------------------------------------
+	mpfr_mul (Temp1, x, hgt_init.myPi, MPFR_RNDN);
+	mpfr_sin (Temp1, Temp1, MPFR_RNDN);
+	mpfr_div (Temp1, Temp1, hgt_init.myPi, MPFR_RNDN);
+	mpfr_mul (SumRe, SumRe, Temp1, MPFR_RNDN);
+	mpfr_mul (SumIm, SumIm, Temp1, MPFR_RNDN);
+	}
+
+// -------------------------------------------------------------------
+// Main term = 2 [cos(Phase) SumRe - sin(Phase) SumIm], with
+// Phase = theta(t) - tau * LogMid.
+// -------------------------------------------------------------------
+ThetaOfT(&Theta, t);
+mpfr_mul (Temp1, tau, gw->LogMid, MPFR_RNDN);
+mpfr_sub (Phase, Theta, Temp1, MPFR_RNDN);
+mpfr_sin_cos (Sin, Cos, Phase, MPFR_RNDN);
+mpfr_fmms (Temp1, Cos, SumRe, Sin, SumIm, MPFR_RNDN);
+mpfr_mul_2ui (Temp1, Temp1, 1, MPFR_RNDN);
+
+// ---------------------------------------------------------------
+// Compute N and P for the given 't' and the remainder term, just
+// as HardyZSingle does.
+// ---------------------------------------------------------------
+mpfr_div (tOver2Pi, t, hgt_init.my2Pi, MPFR_RNDN);
+mpfr_sqrt (T, tOver2Pi, MPFR_RNDN);
+mpfr_modf (N, P, T, MPFR_RNDN);
+ui64N = mpfr_get_uj (N, MPFR_RNDN);
+nEven = (ui64N % 2 == 0) ? true : false;
+RS_Remainder(&Remainder, tOver2Pi, nEven, P, hgt_init.DefaultBits);
+mpfr_add (*Result, Temp1, Remainder, MPFR_RNDN);
+
+mpfr_clears (tau, x, d, Gauss, Ratio, RatioStep, Weight,
+	SumRe, SumIm, Theta, Phase, Sin, Cos, Temp1, (mpfr_ptr) 0);
+mpfr_clears (tOver2Pi, T, N, P, Remainder, (mpfr_ptr) 0);
+return(1);
+}
@@ -0,0 +1,399 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file computes Hardy Z values for t, t + Incr, t + 2 Incr, ...
+// by stepping.  Write the main term of the Riemann-Siegel formula as
+//
+//		Main(t) = 2 * Re[ e^{i theta(t)} F(t) ],
+//		F(t)	= SUM_{n=1}^{N} w_n(t),		w_n(t) = n^{-1/2} e^{-i t log n}.
+//
+// Going from one point to the next, each w_n is simply rotated:
+// w_n(t + Incr) = w_n(t) * e^{-i Incr log n}.  So, once w_n and the
+// rotation r_n = e^{-i Incr log n} are known, each further point costs
+// one complex multiply per term, instead of the log and cos (and
+// 1/sqrt) that RS_MainTerm computes for every term.
+//
+// The points are split into segments of HGT_STEP_RESYNC points.  At
+// the start of each segment w_n and theta are computed exactly, which
+// bounds the error built up by the rotations.  Within a segment theta
+// is advanced by its Taylor series about the first point (the
+// derivatives of theta are known in closed form).  As t grows so does
+// N, so each segment sets up w_n for every n it will need and each
+// point sums only its own n = 1..N.  To keep memory small, a segment
+// works through n in blocks of HGT_STEP_BLOCK terms, adding each
+// block into the running sums of all of its points.
+//
+// The remainder term is computed for each point with RS_Remainder.
+// Each segment is a pool task, and the results are passed to the
+// callback in order.
+// -------------------------------------------------------------------
+
+struct stepItem {
+	struct computeHZ	comphz;
+	struct HGT_BATCH	*Batch;
+	int					Done;
+};
+
+struct stepSegment {
+	struct stepItem		*items;		// first point of the segment
+	int					Count;		// points in the segment
+	mpfr_t				Incr;
+};
+
+static void	StepSegmentTask(void *Arg);
+static int	StepTheta(mpfr_t *Theta, int Count, struct stepItem *items, int Bits);
+static int	StepSplitT(mpfr_t t, uint64_t *N, mpfr_t tOver2Pi, mpfr_t P);
+
+// *******************************************************************
+// We compute the Hardy Z values for t, t + Incr, ..., (Count values)
+// by stepping, as described above, and pass them to pCallbackRange in
+// order.  The 't' values are generated exactly as in HardyZWithRange
+// (by repeated addition of Incr).  The points are handed out in 
+// windows of up to HGT_STEP_WINDOW, so the memory we use does not 
+// depend on Count.
+// *******************************************************************
+int HardyZWithStep(mpfr_t t, mpfr_t Incr, uint64_t Count, int CallerID, 
+	pHardyZRangeCallback pCallbackRange)
+{
+struct stepItem		*items;
+struct stepSegment	*segs;
+struct HGT_BATCH	*Batch;
+mpfr_t				localT;	// to avoid overwriting the passed 't'
+uint64_t			Done;
+int					i, Size, Window, nSegs;
+
+if(Count < 1) {
+	return(1);
+	}
+mpfr_init2 (localT, hgt_init.DefaultBits);
+mpfr_set (localT, t, MPFR_RNDN);
+Batch = PoolBatchCreate();
+
+Size  = Count < HGT_STEP_WINDOW ? (int) Count : HGT_STEP_WINDOW;
+nSegs = (Size + HGT_STEP_RESYNC - 1) / HGT_STEP_RESYNC;
+items = malloc(Size * sizeof(struct stepItem));
+segs  = malloc(nSegs * sizeof(struct stepSegment));
+for(i = 0; i < Size; i++) {
+	mpfr_inits2 (hgt_init.DefaultBits, items[i].comphz.t, items[i].comphz.Result, (mpfr_ptr) 0);
+	items[i].Batch	= Batch;
+	}
+for(i = 0; i < nSegs; i++) {
+	segs[i].items = &items[i * HGT_STEP_RESYNC];
+	mpfr_init2 (segs[i].Incr, hgt_init.DefaultBits);
+	mpfr_set (segs[i].Incr, Incr, MPFR_RNDN);
+	}
+
+for(Done = 0; Done < Count; Done += Window)
+	{
+	Window = Count - Done < (uint64_t) Size ? (int) (Count - Done) : Size;
+	for(i = 0; i < Window; i++) {
+		mpfr_set (items[i].comphz.t, localT, MPFR_RNDN);
+		mpfr_set_ui (items[i].comphz.Result, 0, MPFR_RNDN);
+		mpfr_add (localT, localT, Incr, MPFR_RNDN);
+		items[i].Done	= 0;
+		}
+
+	// ---------------------------------------------------------------
+	// One pool task per segment.  Each task marks its points done as
+	// they are finished, and we pass them on in order.
+	// ---------------------------------------------------------------
+	for(i = 0; i * HGT_STEP_RESYNC < Window; i++) {
+		segs[i].Count = Window - i * HGT_STEP_RESYNC < HGT_STEP_RESYNC
+					  ? Window - i * HGT_STEP_RESYNC : HGT_STEP_RESYNC;
+		PoolSubmit(Batch, StepSegmentTask, &segs[i]);
+		}
+	for(i = 0; i < Window; i++) {
+		PoolWaitItem(Batch, &items[i].Done);
+		pCallbackRange(items[i].comphz.t, items[i].comphz.Result, Done + i, CallerID);
+		}
+	PoolWaitBatch(Batch);
+	}
+
+// -------------------------------------------------------------------
+// We are done.  Clear our local MPFR variables.
+// -------------------------------------------------------------------
+for(i = 0; i < nSegs; i++) {
+	mpfr_clear (segs[i].Incr);
+	}
+for(i = 0; i < Size; i++) {
+	mpfr_clears (items[i].comphz.t, items[i].comphz.Result, (mpfr_ptr) 0);
+	}
+free(segs);
+free(items);
+PoolBatchFree(Batch);
+mpfr_clear(localT);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Compute N and P for the given 't' exactly as HardyZSingle does.
+// -------------------------------------------------------------------
+static int StepSplitT(mpfr_t t, uint64_t *N, mpfr_t tOver2Pi, mpfr_t P)
+{
+mpfr_t		T, Whole;
+
+mpfr_inits2 (hgt_init.DefaultBits, T, Whole, (mpfr_ptr) 0);
+mpfr_div (tOver2Pi, t, hgt_init.my2Pi, MPFR_RNDN);
+mpfr_sqrt (T, tOver2Pi, MPFR_RNDN);
+mpfr_modf (Whole, P, T, MPFR_RNDN);
+*N = mpfr_get_uj (Whole, MPFR_RNDN);
+mpfr_clears (T, Whole, (mpfr_ptr) 0);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// The pool task for one segment of points.
+// -------------------------------------------------------------------
+static void StepSegmentTask(void *Arg)
+{
+struct stepSegment	*seg = (struct stepSegment *) Arg;
+struct stepItem		*items = seg->items;
+mpfr_t				*SumRe, *SumIm, *Theta, *wRe, *wIm, *rRe, *rIm;
+mpfr_t				tOver2Pi, P, Remainder, Log, Recip, Phase, Temp1, Temp2;
+mpfr_t				TabLog, TabRecip;		// views into the table (not init'ed)
+mpfr_ptr			pLog, pRecip;
+const void			*Table;
+uint64_t			*N, NMax, nFirst, nLast, n;
+int					Bits, k, b, Block;
+
+Bits = hgt_init.DefaultBits + HGT_STEP_GUARD_BITS;
+mpfr_inits2 (Bits, Log, Recip, Phase, Temp1, Temp2, (mpfr_ptr) 0);
+mpfr_inits2 (hgt_init.DefaultBits, tOver2Pi, P, Remainder, (mpfr_ptr) 0);
+
+SumRe = malloc(seg->Count * sizeof(mpfr_t));
+SumIm = malloc(seg->Count * sizeof(mpfr_t));
+Theta = malloc(seg->Count * sizeof(mpfr_t));
+N	  = malloc(seg->Count * sizeof(uint64_t));
+for(k = 0; k < seg->Count; k++) {
+	mpfr_inits2 (Bits, SumRe[k], SumIm[k], Theta[k], (mpfr_ptr) 0);
+	mpfr_set_zero (SumRe[k], 1);
+	mpfr_set_zero (SumIm[k], 1);
+	StepSplitT(items[k].comphz.t, &N[k], tOver2Pi, P);
+	}
+NMax = N[seg->Count - 1] > N[0] ? N[seg->Count - 1] : N[0];
+
+wRe = malloc(HGT_STEP_BLOCK * sizeof(mpfr_t));
+wIm = malloc(HGT_STEP_BLOCK * sizeof(mpfr_t));
+rRe = malloc(HGT_STEP_BLOCK * sizeof(mpfr_t));
+rIm = malloc(HGT_STEP_BLOCK * sizeof(mpfr_t));
+for(b = 0; b < HGT_STEP_BLOCK; b++) {
+	mpfr_inits2 (Bits, wRe[b], wIm[b], rRe[b], rIm[b], (mpfr_ptr) 0);
+	}
+
+// -------------------------------------------------------------------
+// Work through n = 1..NMax in blocks.  For each block, set up w_n at
+// the first point and the rotations r_n, then step through the points.
+// log n and 1/sqrt(n) come from the table when one is open, at our
+// working precision (guard bits included).
+// -------------------------------------------------------------------
+Table = TableAcquire(HGT_BACKEND_MPFR, Bits, NMax);
+for(nFirst = 1; nFirst <= NMax; nFirst += HGT_STEP_BLOCK) {
+	nLast = nFirst + HGT_STEP_BLOCK - 1 < NMax ? nFirst + HGT_STEP_BLOCK - 1 : NMax;
+	Block = (int) (nLast - nFirst + 1);
+	for(b = 0, n = nFirst; b < Block; b++, n++) {
+		if(Table != NULL) {
+			TableViewMPFR(Table, n, TabLog, TabRecip);
+			pLog   = TabLog;
+			pRecip = TabRecip;
+			}
+		else {
+			mpfr_set_uj (Temp1, n, MPFR_RNDN);
+			mpfr_log (Log, Temp1, MPFR_RNDN);
+			mpfr_rec_sqrt (Recip, Temp1, MPFR_RNDN);
+			pLog   = Log;
+			pRecip = Recip;
+			}
+		// w_n = n^{-1/2} e^{-i t log n} at the first point
+		mpfr_mul (Phase, items[0].comphz.t, pLog, MPFR_RNDN);
+		mpfr_neg (Phase, Phase, MPFR_RNDN);
+		mpfr_sin_cos (wIm[b], wRe[b], Phase, MPFR_RNDN);
+		mpfr_mul (wRe[b], wRe[b], pRecip, MPFR_RNDN);
+		mpfr_mul (wIm[b], wIm[b], pRecip, MPFR_RNDN);
+		// r_n = e^{-i Incr log n}
+		mpfr_mul (Phase, seg->Incr, pLog, MPFR_RNDN);
+		mpfr_neg (Phase, Phase, MPFR_RNDN);
+		mpfr_sin_cos (rIm[b], rRe[b], Phase, MPFR_RNDN);
+		}
+
+	for(k = 0; k < seg->Count; k++) {
+		for(b = 0, n = nFirst; b < Block; b++, n++) {
+			if(k > 0) {						// w_n = w_n * r_n
+				mpfr_fmms (Temp1, wRe[b], rRe[b], wIm[b], rIm[b], MPFR_RNDN);
+				mpfr_fmma (Temp2, wRe[b], rIm[b], wIm[b], rRe[b], MPFR_RNDN);
+				mpfr_swap (wRe[b], Temp1);
+				mpfr_swap (wIm[b], Temp2);
+				}
+			if(n <= N[k]) {
+				mpfr_add (SumRe[k], SumRe[k], wRe[b], MPFR_RNDN);
+				mpfr_add (SumIm[k], SumIm[k], wIm[b], MPFR_RNDN);
+				}
+			}
+		}
+	}
+if(Table != NULL) {
+	TableRelease(HGT_BACKEND_MPFR);
+	}
+
+// -------------------------------------------------------------------
+// Main = 2 Re[e^{i theta} F] = 2 (cos(theta) SumRe - sin(theta) SumIm),
+// then add the remainder.  Mark each point done as we go.
+// -------------------------------------------------------------------
+StepTheta(Theta, seg->Count, items, Bits);
+for(k = 0; k < seg->Count; k++) {
+	mpfr_sin_cos (Temp2, Temp1, Theta[k], MPFR_RNDN);
+	mpfr_fmms (Phase, Temp1, SumRe[k], Temp2, SumIm[k], MPFR_RNDN);
+	mpfr_mul_2ui (Phase, Phase, 1, MPFR_RNDN);
+	if(N[k] < 1) {
+		mpfr_set_zero (Phase, 1);
+		}
+	StepSplitT(items[k].comphz.t, &n, tOver2Pi, P);
+	RS_Remainder(&Remainder, tOver2Pi, (n % 2 == 0) ? true : false, P, hgt_init.DefaultBits);
+	mpfr_add (items[k].comphz.Result, Phase, Remainder, MPFR_RNDN);
+	PoolItemDone(items[k].Batch, &items[k].Done);
+	}
+
+// -------------------------------------------------------------------
+// Clear our local MPFR variables.
+// -------------------------------------------------------------------
+for(b = 0; b < HGT_STEP_BLOCK; b++) {
+	mpfr_clears (wRe[b], wIm[b], rRe[b], rIm[b], (mpfr_ptr) 0);
+	}
+for(k = 0; k < seg->Count; k++) {
+	mpfr_clears (SumRe[k], SumIm[k], Theta[k], (mpfr_ptr) 0);
+	}
+free(wRe);
+free(wIm);
+free(rRe);
+free(rIm);
+free(SumRe);
+free(SumIm);
+free(Theta);
+free(N);
+mpfr_clears (Log, Recip, Phase, Temp1, Temp2, (mpfr_ptr) 0);
+mpfr_clears (tOver2Pi, P, Remainder, (mpfr_ptr) 0);
+}
+
+// -------------------------------------------------------------------
+// theta(t) for the points of a segment.  We compute theta exactly at
+// the first point, t0, and advance it by the Taylor series
+//
+//		theta(t0 + x) = theta(t0) + SUM_{j >= 1} theta^(j)(t0) x^j / j!
+//
+// where, from the formula used by ThetaOfT,
+//
+//		theta'(t)	  = log(t / 2 pi) / 2 - 1/(48 t^2) - 7/(1920 t^4)
+//		theta^(j)(t) = (-1)^j [ (j - 2)! / (2 t^{j-1})
+//					   + j! / (48 t^{j+1}) + 7 (j + 2)! / (11520 t^{j+3}) ]
+//
+// for j >= 2 (the last term only when t < THETA_MAX_T_POWER3, as in
+// ThetaOfT).  The series converges quickly when x is small next to t;
+// otherwise we compute theta at each point with ThetaOfT.
+// -------------------------------------------------------------------
+static int StepTheta(mpfr_t *Theta, int Count, struct stepItem *items, int Bits)
+{
+mpfr_t		Coeff[HGT_STEP_THETA_TERMS + 1], t0, x, Recip, Temp1, Temp2;
+double		Ratio;
+int			j, k, Terms;
+bool		Power3;
+
+mpfr_inits2 (Bits, t0, x, Recip, Temp1, Temp2, (mpfr_ptr) 0);
+mpfr_set (t0, items[0].comphz.t, MPFR_RNDN);
+mpfr_sub (x, items[Count - 1].comphz.t, t0, MPFR_RNDN);
+Ratio = fabs(mpfr_get_d (x, MPFR_RNDN) / mpfr_get_d (t0, MPFR_RNDN));
+
+// -------------------------------------------------------------------
+// Number of Taylor terms: the j-th term is about x (x/t)^{j-1} / j^2.
+// -------------------------------------------------------------------
+Terms = 0;
+if(Ratio < 0.25) {
+	Terms = 1;
+	while(Terms < HGT_STEP_THETA_TERMS
+		&& Terms * log2(Ratio > 0.0 ? Ratio : 1e-300)
+		 + log2(1.0 + fabs(mpfr_get_d (x, MPFR_RNDN))) > -(double) Bits) {
+		Terms++;
+		}
+	}
+if(Terms == 0 || Terms == HGT_STEP_THETA_TERMS) {	// too far: exact theta
+	for(k = 0; k < Count; k++) {
+		ThetaOfT(&Theta[k], items[k].comphz.t);
+		}
+	mpfr_clears (t0, x, Recip, Temp1, Temp2, (mpfr_ptr) 0);
+	return(1);
+	}
+
+// -------------------------------------------------------------------
+// Coeff[j] = theta^(j)(t0) / j!, j = 1..Terms.
+// -------------------------------------------------------------------
+Power3 = mpfr_cmp_d (t0, THETA_MAX_T_POWER3) < 0;
+mpfr_ui_div (Recip, 1, t0, MPFR_RNDN);
+for(j = 1; j <= Terms; j++) {
+	mpfr_init2 (Coeff[j], Bits);
+	}
+mpfr_div (Temp1, t0, hgt_init.my2Pi, MPFR_RNDN);
+mpfr_log (Coeff[1], Temp1, MPFR_RNDN);
+mpfr_div_2ui (Coeff[1], Coeff[1], 1, MPFR_RNDN);
+mpfr_sqr (Temp1, Recip, MPFR_RNDN);
+mpfr_div_ui (Temp2, Temp1, 48, MPFR_RNDN);
+mpfr_sub (Coeff[1], Coeff[1], Temp2, MPFR_RNDN);
+if(Power3) {
+	mpfr_sqr (Temp2, Temp1, MPFR_RNDN);
+	mpfr_mul_ui (Temp2, Temp2, 7, MPFR_RNDN);
+	mpfr_div_ui (Temp2, Temp2, 1920, MPFR_RNDN);
+	mpfr_sub (Coeff[1], Coeff[1], Temp2, MPFR_RNDN);
+	}
+for(j = 2; j <= Terms; j++) {
+	// 1 / (2 j (j - 1) t^{j-1})
+	mpfr_pow_ui (Temp1, Recip, j - 1, MPFR_RNDN);
+	mpfr_div_ui (Coeff[j], Temp1, 2 * j * (j - 1), MPFR_RNDN);
+	// + 1 / (48 t^{j+1})
+	mpfr_mul (Temp1, Temp1, Recip, MPFR_RNDN);
+	mpfr_mul (Temp1, Temp1, Recip, MPFR_RNDN);
+	mpfr_div_ui (Temp2, Temp1, 48, MPFR_RNDN);
+	mpfr_add (Coeff[j], Coeff[j], Temp2, MPFR_RNDN);
+	// + 7 (j + 1)(j + 2) / (11520 t^{j+3})
+	if(Power3) {
+		mpfr_mul (Temp1, Temp1, Recip, MPFR_RNDN);
+		mpfr_mul (Temp1, Temp1, Recip, MPFR_RNDN);
+		mpfr_mul_ui (Temp2, Temp1, 7 * (j + 1) * (j + 2), MPFR_RNDN);
+		mpfr_div_ui (Temp2, Temp2, 11520, MPFR_RNDN);
+		mpfr_add (Coeff[j], Coeff[j], Temp2, MPFR_RNDN);
+		}
+	if(j % 2 == 1) {
+		mpfr_neg (Coeff[j], Coeff[j], MPFR_RNDN);
+		}
+	}
+
+// -------------------------------------------------------------------
+// theta(t0 + x) by Horner's rule in x, for each point.
+// -------------------------------------------------------------------
+ThetaOfT(&Temp1, t0);
+for(k = 0; k < Count; k++) {
+	mpfr_sub (x, items[k].comphz.t, t0, MPFR_RNDN);
+	mpfr_set (Temp2, Coeff[Terms], MPFR_RNDN);
+	for(j = Terms - 1; j >= 1; j--) {
+		mpfr_fma (Temp2, Temp2, x, Coeff[j], MPFR_RNDN);
+		}
+	mpfr_fma (Theta[k], Temp2, x, Temp1, MPFR_RNDN);
+	}
+
+for(j = 1; j <= Terms; j++) {
+	mpfr_clear (Coeff[j]);
+	}
+mpfr_clears (t0, x, Recip, Temp1, Temp2, (mpfr_ptr) 0);
+return(1);
+}
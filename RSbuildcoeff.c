@@ -1,5 +1,5 @@
 // -------------------------------------------------------------------
-// Program last modified January 9, 2026. 
+// Program last modified October 16, 2026. 
 // Copyright (c) 2024-2026 Terrence P. Murphy
 // MIT License -- see hgt.h for details.
 // -------------------------------------------------------------------
@@ -10,14 +10,34 @@
 #include <string.h>
 #include <stdbool.h>
 #include <ctype.h>
+#include <pthread.h>
 #include <mpfr.h>
 
 #include "hgt.h"
 
-extern struct	HGT_INIT	hgt_init;
+struct coeffBinary {
+	int			Sign;
+	uint64_t	K[3];
+};
 
-// holds coefficients in MPFR form; the bracketed values are [5][44]
-mpfr_t	coeffMPFR[GABCKE_NUM_Cj_TERMS][GABCKE_COEFF_PER_Cj];
+// -------------------------------------------------------------------
+// The coefficients already made at each precision, kept until 
+// CloseMPFR (see FreeCoefficientCache), so that a later context at the
+// same precision (another HgtContextCreate) only copies them.  Entries
+// are added and freed under coeffLock and never changed.
+// -------------------------------------------------------------------
+struct coeffCache {
+	struct coeffCache	*Next;
+	int					Bits;
+	mpfr_t				Coeff[GABCKE_NUM_Cj_TERMS][GABCKE_COEFF_PER_Cj];
+};
+
+static pthread_once_t		coeffOnce = PTHREAD_ONCE_INIT;
+static pthread_mutex_t		coeffLock = PTHREAD_MUTEX_INITIALIZER;
+static struct coeffCache	*coeffCacheList = NULL;
+
+static void					BuildCoefficientsOnce(void);
+static struct coeffCache *	CoeffCacheFind(int Bits);
 
 // -------------------------------------------------------------------
 // The following table of power series coefficients is used to calculate
@@ -260,82 +280,434 @@ const char coeffGabcke[GABCKE_NUM_Cj_TERMS][GABCKE_COEFF_PER_Cj][64]={
 	 "0.                                                   95 26704",
 	"-0.                                                    2 03596"}};// 86
 
-
-
+// -------------------------------------------------------------------
+// The same table in binary, as made from coeffGabcke (once, offline):
+// each coefficient is Sign * K / 10^50, with K (the 50 digits as an
+// integer, below 2^167) held in three 64-bit words, least significant
+// first.  One exact division turns this into the correctly rounded
+// coefficient at any precision, the same value mpfr_set_str gives for
+// the string, without parsing it (see CoeffBinToMPFR).  With debug
+// flag PRINT_COEFF, BuildCoefficientsMPFR checks the two agree.
+// -------------------------------------------------------------------
+static const struct coeffBinary coeffGabckeBinary[GABCKE_NUM_Cj_TERMS][GABCKE_COEFF_PER_Cj]={
+	{
+	{ 1, {0x823e56d37d30c8f3u, 0x9c8ac52031f531b7u, 0x0000001a2f2bdc08u}},
+	{ 1, {0x6aecb675f5b878acu, 0x012752cb9a810f02u, 0x0000001deace1194u}},
+	{ 1, {0xe3abf60ed4426c1bu, 0x96034fa24587abe9u, 0x000000090ebd181cu}},
+	{-1, {0x0338824972a350deu, 0x7530741b2b59d9a4u, 0x00000000ee4f0bf7u}},
+	{-1, {0x3e94499ff59b713cu, 0xfcbe49ef94cd3d33u, 0x00000000eda75230u}},
+	{-1, {0x2894cd2a5b634729u, 0x292daa764ba53defu, 0x000000001c710942u}},
+	{ 1, {0x0e4f3ea1e987d261u, 0xc1c51c970559acf1u, 0x00000000053408bcu}},
+	{ 1, {0xfbb704ce5ded5ba6u, 0x46e2c95bc0488f3eu, 0x000000000164309fu}},
+	{ 1, {0xa0bf8c86de4afef1u, 0x2758f8440ccbe5eeu, 0x0000000000021670u}},
+	{-1, {0x04691cd9ab2f128bu, 0x1578d3c9ff8d8377u, 0x0000000000066cb0u}},
+	{-1, {0xf233fa53ca83a26eu, 0x292450c5ee8c04dbu, 0x00000000000076deu}},
+	{ 1, {0x5f76655caa2643a6u, 0xab1a36b0afdd01bfu, 0x0000000000000e2fu}},
+	{ 1, {0xdfff01f47845af50u, 0x7a52d7130f800bc0u, 0x000000000000020du}},
+	{-1, {0xa9d65bdd99fb3b10u, 0xf76aa719e0e63620u, 0x0000000000000009u}},
+	{-1, {0xd6c1a63c6dfa0982u, 0xcc4787ff582569ecu, 0x0000000000000004u}},
+	{-1, {0xfcf9b676e24e2158u, 0x1c79dafa243eff8fu, 0x0000000000000000u}},
+	{ 1, {0xb3752f4de56e46b0u, 0x07046578e3dfd730u, 0x0000000000000000u}},
+	{ 1, {0x1adeec6656eb5763u, 0x006491ac7e5d4125u, 0x0000000000000000u}},
+	{-1, {0xb7a97d79374d756du, 0x00067402661fc67du, 0x0000000000000000u}},
+	{-1, {0x7b212f60931c4b8bu, 0x0000a83ee0c56e7du, 0x0000000000000000u}},
+	{ 1, {0x73224a4cf109c99eu, 0x000002d5e7670761u, 0x0000000000000000u}},
+	{ 1, {0x02b00536c743a5a3u, 0x000000bc0150817bu, 0x0000000000000000u}},
+	{ 1, {0xf13e093ebbdd6a7du, 0x00000001960253b6u, 0x0000000000000000u}},
+	{-1, {0x9353cf8aef109997u, 0x00000000988da393u, 0x0000000000000000u}},
+	{-1, {0x26be59cdc5cabebdu, 0x0000000004499779u, 0x0000000000000000u}},
+	{ 1, {0xd3fcaf1e0a2f34b1u, 0x00000000005b6e91u, 0x0000000000000000u}},
+	{ 1, {0x6d7201e847f6bb08u, 0x0000000000048c98u, 0x0000000000000000u}},
+	{-1, {0x3fbed4db6785138bu, 0x000000000000269bu, 0x0000000000000000u}},
+	{-1, {0x8637456efb00a9b4u, 0x0000000000000352u, 0x0000000000000000u}},
+	{ 1, {0x9630e1e85e65f08bu, 0x0000000000000008u, 0x0000000000000000u}},
+	{ 1, {0xdca63d861aca3e1cu, 0x0000000000000001u, 0x0000000000000000u}},
+	{ 1, {0x025cb565daf6d582u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x00d4fd4add94bab7u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0003b9d96481ea25u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x00004c994fc16c45u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x00000259cc5afc3cu, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x00000015c3a09315u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x00000001105bcdd9u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x00000000047f5de6u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x0000000000629978u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000000000006ceau, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000000000001db9u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000000000000026u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x0000000000000008u, 0x0000000000000000u, 0x0000000000000000u}}},
+	{
+	{ 1, {0x16dfe49ab91ca538u, 0xf88843a008486778u, 0x00000001d5dfeb9du}},
+	{-1, {0x01123610d392b809u, 0x82acb5abfef57287u, 0x00000000f1750fd6u}},
+	{-1, {0xbf2db64f9bf5c58bu, 0x7cfdc572269cd02cu, 0x00000002a238bc92u}},
+	{-1, {0xdab8d707168036d3u, 0xc8f16e0193930460u, 0x00000000ace76463u}},
+	{ 1, {0xaac62d746e5a1b4cu, 0xf4673fd183a4a4ccu, 0x0000000039fdf5d0u}},
+	{ 1, {0xf401bc3f666f854du, 0xe1fe1d2dfd72610du, 0x0000000019a84df5u}},
+	{ 1, {0xb8a4d72823635e35u, 0xe5cb645c9c59b6deu, 0x00000000003b39f8u}},
+	{-1, {0xf6292b73933fd4ecu, 0x19d4cdc75a18aed3u, 0x00000000010995d2u}},
+	{-1, {0x70bb308f61f81a19u, 0x580ab46433cceca7u, 0x00000000001ad0fbu}},
+	{ 1, {0x743863577ca0715eu, 0x0085d49fb38596b2u, 0x00000000000452c5u}},
+	{ 1, {0x7301ce635ae181c3u, 0xf095e4eb3d84ee0au, 0x000000000000d278u}},
+	{-1, {0x398e04be86602393u, 0xc251032b61b6d877u, 0x0000000000000520u}},
+	{-1, {0xf3036b32ce5a5808u, 0x4a496e67f5e583feu, 0x000000000000031cu}},
+	{-1, {0xfaa295a28b46b0c8u, 0xe1000df401f23145u, 0x0000000000000016u}},
+	{ 1, {0x8aed27a571f1eab1u, 0xe34041f1e56d9392u, 0x0000000000000006u}},
+	{ 1, {0xfc766f68ba7da67fu, 0x7717cdc5e8057e24u, 0x0000000000000000u}},
+	{-1, {0x9506de075572f6e0u, 0x091e37414c13c07au, 0x0000000000000000u}},
+	{-1, {0x11f19ea4bc953c15u, 0x0118df97b17a7ccau, 0x0000000000000000u}},
+	{ 1, {0x391ea92a218a5f79u, 0x00058b4640d08f5cu, 0x0000000000000000u}},
+	{ 1, {0x2c3e6f5f5005a0b0u, 0x0001ab1cb3b1d773u, 0x0000000000000000u}},
+	{ 1, {0x72c8d7626d992743u, 0x000004281b57e5a0u, 0x0000000000000000u}},
+	{-1, {0x1a2745c75fd45559u, 0x000001ca45b56dbbu, 0x0000000000000000u}},
+	{-1, {0xf68b77dbf24385cdu, 0x0000000eacc9ef59u, 0x0000000000000000u}},
+	{ 1, {0x5ca9e610504c8114u, 0x0000000162a31924u, 0x0000000000000000u}},
+	{ 1, {0xbe1afc9056352347u, 0x0000000013e547f5u, 0x0000000000000000u}},
+	{-1, {0x9c172134f64fe3f7u, 0x0000000000bd8049u, 0x0000000000000000u}},
+	{-1, {0x1e42924df8be370fu, 0x00000000001239a1u, 0x0000000000000000u}},
+	{ 1, {0x8f349e4ca5cd2aefu, 0x000000000000346eu, 0x0000000000000000u}},
+	{ 1, {0xd1f51c9b23124547u, 0x0000000000000c9bu, 0x0000000000000000u}},
+	{ 1, {0xadd3b8d54c6ba309u, 0x0000000000000011u, 0x0000000000000000u}},
+	{-1, {0xdc19a742cf961825u, 0x0000000000000006u, 0x0000000000000000u}},
+	{-1, {0x21bda88ccdb02a8eu, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x02f7ad5b0bd424e1u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x0019771359e3a346u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x000100de35b855a7u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x00000da5dfb8d065u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x0000003e91ab4925u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x00000005cc67dbc0u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000000006ead78au, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x000000000208e5cau, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x000000000002c8c9u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x00000000000099a0u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x0000000000000232u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000000000000026u, 0x0000000000000000u, 0x0000000000000000u}}},
+	{
+	{ 1, {0x1c507f0de61ec77fu, 0x80952212b9c7bca5u, 0x000000005ae23b10u}},
+	{ 1, {0x86deed936b09bdcbu, 0x528494a1aed3c565u, 0x00000000056bb15cu}},
+	{-1, {0x7e8c576ae5d44902u, 0xada0cb8c2599aafbu, 0x00000000c6901e2au}},
+	{ 1, {0xe0481f6de63fb608u, 0xb32c092cce169b69u, 0x00000000271d52cbu}},
+	{ 1, {0x32f6448a5c7bd50au, 0x58ec9202e98a29e0u, 0x000000005b06872fu}},
+	{ 1, {0xfed363e15de8d4e5u, 0xd6360b263f0b9fc1u, 0x00000000060682ceu}},
+	{-1, {0xda5bce123c06ae46u, 0xe79aec30eb0bc24bu, 0x000000000a5a6d29u}},
+	{-1, {0xc64962445b9912c9u, 0x5910e7d18781b69bu, 0x0000000001caba53u}},
+	{ 1, {0xdb6c28f8136d6288u, 0xc3201dc44c0e30f3u, 0x00000000005daab2u}},
+	{ 1, {0x3160682f359f9c5au, 0x533ea7cddb632d3fu, 0x00000000001a94a0u}},
+	{-1, {0x39d279667707b9bdu, 0x52b26630f93444ccu, 0x000000000000bc89u}},
+	{-1, {0x3026e89c2c31dbbcu, 0xc2f1b0099bdc23ceu, 0x000000000000ae0au}},
+	{-1, {0x58f2ab910de3b74cu, 0x25c07ab890b91633u, 0x00000000000006c8u}},
+	{ 1, {0xcb377f7de7ed8a49u, 0x88c0a67e7f200019u, 0x0000000000000266u}},
+	{ 1, {0x6129c6507b097e0au, 0x5b014d1605832f5au, 0x0000000000000034u}},
+	{-1, {0x4b0f20c693c43610u, 0xc00cb62eb3966169u, 0x0000000000000004u}},
+	{-1, {0x19a8e6ef63bff818u, 0xb31a8abdb59cc11eu, 0x0000000000000000u}},
+	{ 1, {0x49848aca471b8acbu, 0x040fab0729a2acb5u, 0x0000000000000000u}},
+	{ 1, {0x6e195c9266d75b27u, 0x017c5fb81531dd45u, 0x0000000000000000u}},
+	{ 1, {0x962e2635ec119cdcu, 0x00047e66350b15d2u, 0x0000000000000000u}},
+	{-1, {0x597d573f9ebf8b60u, 0x000227965305a09au, 0x0000000000000000u}},
+	{-1, {0x2d32d8631f4a8dc3u, 0x00001487b807f81au, 0x0000000000000000u}},
+	{ 1, {0x82b1e9508d137307u, 0x000002312ca0f456u, 0x0000000000000000u}},
+	{ 1, {0x33288b03eb752ca2u, 0x0000002407bf4572u, 0x0000000000000000u}},
+	{-1, {0xe284ccc44202a92du, 0x0000000180eff0d2u, 0x0000000000000000u}},
+	{-1, {0xd0ef280561f7d3e9u, 0x0000000029f22800u, 0x0000000000000000u}},
+	{ 1, {0x887b62d5ea49a46bu, 0x0000000000855f65u, 0x0000000000000000u}},
+	{ 1, {0xaa7e216051e06b88u, 0x000000000024404cu, 0x0000000000000000u}},
+	{ 1, {0xc575421f4bbfb02cu, 0x0000000000003991u, 0x0000000000000000u}},
+	{-1, {0xe157a2c209c0fd1fu, 0x0000000000001843u, 0x0000000000000000u}},
+	{-1, {0x5b0f7cdb389b47a3u, 0x0000000000000084u, 0x0000000000000000u}},
+	{ 1, {0xbe115587c2ee37d3u, 0x000000000000000cu, 0x0000000000000000u}},
+	{ 1, {0x784f651ff3de021eu, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x052b05d321a5bd5cu, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x004ce6f3dba2a987u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x00017e4d609cfdd4u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x000026997469e24bu, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x000000316ee56f73u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000000fdd290a13u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000000017927137u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x00000000056fc8dfu, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x0000000000157195u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000000000018f60u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000000000000a35u, 0x0000000000000000u, 0x0000000000000000u}}},
+	{
+	{ 1, {0x27d87dcf68c0e6f5u, 0x162c162a7eea42feu, 0x0000000017777ea6u}},
+	{-1, {0x68500f201d29db75u, 0x44f21fcd5db7ea8eu, 0x000000004195a42fu}},
+	{ 1, {0xb30915ee0c19d022u, 0xb0e63e52e12ec3b1u, 0x00000000174d5a0bu}},
+	{ 1, {0x1ccaaf43ad813619u, 0xbd7cc5e1eef97581u, 0x0000000027aeb383u}},
+	{-1, {0x1bdb246f9c863cb9u, 0x2d4196c46669f525u, 0x0000000010b9b20bu}},
+	{-1, {0x7ce9032866485523u, 0x6b1cec1f20d07425u, 0x000000000a86fe94u}},
+	{ 1, {0xa352113700b08953u, 0x3dafca0c89f216f9u, 0x0000000001c63197u}},
+	{ 1, {0xfd3f7306ee6d6892u, 0x35b2c2837bee5e3au, 0x000000000133dec1u}},
+	{-1, {0x2a6fffcef604b0ffu, 0x1f0bf7137506238fu, 0x000000000002af16u}},
+	{-1, {0x7d60a21222e8b7c3u, 0xd5602849f4fc5aa6u, 0x00000000000ef08eu}},
+	{-1, {0xb67f6098ffc68c2du, 0x005434bff55e4e3eu, 0x000000000000fb9fu}},
+	{ 1, {0xff97e8998063c4f3u, 0x3981a52864beaa94u, 0x0000000000005a95u}},
+	{ 1, {0x4f847a756d784749u, 0xba2f26822311f22au, 0x0000000000000aceu}},
+	{-1, {0x6a0616760898b354u, 0x3d8d61be0d2e21acu, 0x0000000000000119u}},
+	{-1, {0xc6cb444a0a322f29u, 0x23d0d3c54c56a7ceu, 0x0000000000000037u}},
+	{ 1, {0xe31cc518f5d42027u, 0x4ddda50e4bc3a01fu, 0x0000000000000001u}},
+	{ 1, {0xcf8b3f91d2e96070u, 0xa8b853c630ff58f4u, 0x0000000000000000u}},
+	{ 1, {0x2cf0232170fa7fe1u, 0x02baaac5842573b2u, 0x0000000000000000u}},
+	{-1, {0x940a5eaff3c5f451u, 0x0153baf9ceecbc00u, 0x0000000000000000u}},
+	{-1, {0xa537102ec8182619u, 0x000f54f5d62c4787u, 0x0000000000000000u}},
+	{ 1, {0x24832c7ff84ae6d8u, 0x0001d06cb78205a3u, 0x0000000000000000u}},
+	{ 1, {0xbe522f7f619bfd69u, 0x0000232b3e29952du, 0x0000000000000000u}},
+	{-1, {0x96fa71c3c3116fdfu, 0x0000019f3ebe8698u, 0x0000000000000000u}},
+	{-1, {0x0d66bc6d4c12bba2u, 0x00000034c4ab1cc8u, 0x0000000000000000u}},
+	{ 1, {0x468c004ed5cb51fbu, 0x00000000b3590206u, 0x0000000000000000u}},
+	{ 1, {0xe6f40a8cebfff701u, 0x0000000039be1544u, 0x0000000000000000u}},
+	{ 1, {0x7d7c3b82f23939f6u, 0x00000000006e1ef5u, 0x0000000000000000u}},
+	{-1, {0x21f85def28c1fea6u, 0x0000000000302163u, 0x0000000000000000u}},
+	{-1, {0x58cf87d67938b751u, 0x00000000000128ddu, 0x0000000000000000u}},
+	{ 1, {0x1359ea5983b1773au, 0x0000000000001f01u, 0x0000000000000000u}},
+	{ 1, {0x8672a14387144761u, 0x0000000000000146u, 0x0000000000000000u}},
+	{-1, {0x36ba58d2a77f3c34u, 0x000000000000000fu, 0x0000000000000000u}},
+	{-1, {0xfab3fc68777b2374u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x053ec047c30e566fu, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x0095bb2ea44fe02cu, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000c9184c14ddc4u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000488ee5708ea3u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x000000778e44cbe6u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x0000001d127a662eu, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x000000007cb435edu, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000000009ad797fu, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000000000446c0eu, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x000000000002a5c3u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x0000000000001c36u, 0x0000000000000000u, 0x0000000000000000u}}},
+	{
+	{ 1, {0x4b6f809c6e8a3d3fu, 0x012b1e39c02a1e19u, 0x0000000008246324u}},
+	{-1, {0x8a9964f5c2ce7050u, 0xa8ee70777d94fa34u, 0x00000000119d89e8u}},
+	{ 1, {0xa9e49dc3f76c48c2u, 0xabff7a577bec04e3u, 0x000000000436356au}},
+	{ 1, {0xfca539d27151cf40u, 0xf32959186c0c4100u, 0x0000000012031865u}},
+	{-1, {0x0327d4a00a470e06u, 0xbb1386b212d7c15eu, 0x000000000d69e756u}},
+	{-1, {0x5051e90302e0e598u, 0xf989866d320f387cu, 0x0000000003913606u}},
+	{ 1, {0xf8aeaba2f2568fd2u, 0xdad06f9556f39ef9u, 0x000000000410e006u}},
+	{ 1, {0xe5a40189646f8536u, 0x1888eb5ec9b7a72eu, 0x000000000092316du}},
+	{-1, {0xcecf89486bf0bf74u, 0xdf4eb8b97eaf035fu, 0x000000000072b352u}},
+	{-1, {0x30faf4d910d52196u, 0x4fa022af9c5683fdu, 0x0000000000126b23u}},
+	{ 1, {0xe7de921ca512c19fu, 0xd0323851612ef74bu, 0x0000000000054867u}},
+	{ 1, {0x4f5cf3fdd39a6343u, 0x5fde07e75f52056eu, 0x00000000000118bfu}},
+	{-1, {0xee4b7e6825304858u, 0x3aaea436f020a2dbu, 0x0000000000001b74u}},
+	{-1, {0xf1c412aa1ec2ae8au, 0x958fcdbfb800c74au, 0x000000000000089du}},
+	{ 1, {0xf06edfab82b3fc4fu, 0x1f0bc16dd5ac50c9u, 0x0000000000000027u}},
+	{ 1, {0xb6056de1f70cfb56u, 0x7f9a8dc138004487u, 0x0000000000000027u}},
+	{ 1, {0xeffbb600692e488eu, 0x0858bfda419cbd4cu, 0x0000000000000001u}},
+	{-1, {0xa183e55e18fb2d6bu, 0x7249d9bb9c2e125du, 0x0000000000000000u}},
+	{-1, {0xc0cb6cc85be11785u, 0x06b50c0766d97ed4u, 0x0000000000000000u}},
+	{ 1, {0xd35464fb2407b1dau, 0x00d7a00157cd13bcu, 0x0000000000000000u}},
+	{ 1, {0x0777be0da140d17fu, 0x001440cb7cb68c23u, 0x0000000000000000u}},
+	{-1, {0x71b70d5cd65cee47u, 0x0000ff53d1a974beu, 0x0000000000000000u}},
+	{-1, {0xcb86e967666ac123u, 0x000027c490bae7d6u, 0x0000000000000000u}},
+	{ 1, {0x66b078c217947971u, 0x00000085e4f51f26u, 0x0000000000000000u}},
+	{ 1, {0x1ee9f46cb3bd5f37u, 0x00000037f5feb22fu, 0x0000000000000000u}},
+	{ 1, {0x6e92ed7642041638u, 0x000000008b96a023u, 0x0000000000000000u}},
+	{-1, {0x6636357379fa24b5u, 0x000000003ae7d314u, 0x0000000000000000u}},
+	{-1, {0xa505daadbe3d5a79u, 0x0000000001a782e1u, 0x0000000000000000u}},
+	{ 1, {0x9b0b9a3cc0d312ebu, 0x00000000002f1ba7u, 0x0000000000000000u}},
+	{ 1, {0x5407372be5c7a290u, 0x0000000000023532u, 0x0000000000000000u}},
+	{-1, {0xa214ecf7c4d1a723u, 0x0000000000001c3bu, 0x0000000000000000u}},
+	{-1, {0x07e52c319ea13693u, 0x000000000000020du, 0x0000000000000000u}},
+	{ 1, {0xab3f28dd4c860615u, 0x000000000000000bu, 0x0000000000000000u}},
+	{ 1, {0x7809092c139839d3u, 0x0000000000000001u, 0x0000000000000000u}},
+	{-1, {0x01f933ff7ecae1abu, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x00d875a5716152d7u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0001988284182b14u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x00006617b8b18d1au, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x000001e2f5b6cfd1u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x00000027aa2966e2u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x000000013218dae7u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x000000000c8fcfc0u, 0x0000000000000000u, 0x0000000000000000u}},
+	{ 1, {0x0000000000915db0u, 0x0000000000000000u, 0x0000000000000000u}},
+	{-1, {0x0000000000031b4cu, 0x0000000000000000u, 0x0000000000000000u}}}};
 
 // -------------------------------------------------------------------
 // This function is called when we need to compute Hardy Z values.
-// Before use, we must initialize (one time) the MPFR variables that 
-// will hold the Grabke coefficients, and (for each 't') the MPFR 
-// variables holding the powers of AdjP = 1 - (2 * P).
+// Before use, we must initialize (one time for each context) the MPFR 
+// variables that will hold the Grabke coefficients, and (for each 't') 
+// the MPFR variables holding the powers of AdjP = 1 - (2 * P).
 // -------------------------------------------------------------------
-int InitCoeffMPFR(int iFloatBits)
+int InitCoeffMPFR(struct HGT_CONTEXT *Context)
 {
 int		j;
 
 for(j = 0; j < GABCKE_COEFF_PER_Cj; j++)	// init all coefficient slots
 	{
-	mpfr_inits2 (iFloatBits, coeffMPFR[0][j], coeffMPFR[1][j], 
-	coeffMPFR[2][j], coeffMPFR[3][j], coeffMPFR[4][j],  (mpfr_ptr)0);	
+	mpfr_inits2 (Context->Init.DefaultBits, Context->Coeff[0][j], 
+	Context->Coeff[1][j], Context->Coeff[2][j], Context->Coeff[3][j], 
+	Context->Coeff[4][j], (mpfr_ptr)0);	
 	}
-BuildCoefficientsMPFR();
+BuildCoefficientsMPFR(Context);
+Context->HasCoeff = true;
+pthread_once(&coeffOnce, BuildCoefficientsOnce);
+BuildFixedTables();				// see hgtFixed.c
 return(1);	
 }
 
+// -------------------------------------------------------------------
+// The tables for the other backends do not depend on the precision, 
+// so they are built once, for the first context, and then shared.
+// -------------------------------------------------------------------
+static void BuildCoefficientsOnce(void)
+{
+BuildRemainderBounds();			// see RSremainder.c
+BuildCoefficientsDD();			// for the fast backends; see hgtBackend.c
+BuildCoefficientsQuad();
+BuildSimdTables();
+}
 
 // -------------------------------------------------------------------
-// This function is called by CloseMPFR, which is called after we are 
-// done using all MPFR functions.  Close MPFR clears the remaining 
-// memory and any cache used by MPFR. 
+// This function is called by HgtContextFree (and so by CloseMPFR) to 
+// clear the coefficients of a context.
 // -------------------------------------------------------------------
-int CloseCoeffMPFR(void)
+int CloseCoeffMPFR(struct HGT_CONTEXT *Context)
 {
 int		j;
 
+if(Context->HasCoeff == false) {
+	return(1);
+	}
 for(j = 0; j < GABCKE_COEFF_PER_Cj; j++)	// clear all coefficienbt slots
 	{
-	mpfr_clears (coeffMPFR[0][j], coeffMPFR[1][j], 
-	coeffMPFR[2][j], coeffMPFR[3][j], coeffMPFR[4][j],  (mpfr_ptr)0);	
+	mpfr_clears (Context->Coeff[0][j], Context->Coeff[1][j], 
+	Context->Coeff[2][j], Context->Coeff[3][j], Context->Coeff[4][j], 
+	(mpfr_ptr)0);	
 	}	
-
+Context->HasCoeff = false;
+FreeFixedTables();				// see hgtFixed.c
 return(1);	
 }
 
 // -------------------------------------------------------------------
-// Here, we step through all of the strings in coeffGabcke. For each
-// string we call CoeffStrToMPFR to: (1) convert that string to
-// a valid floating point string (add '0' where needed and remove
-// spaces where neded), and (2) then return the value obtained from
-// a call to mpfr_set_str.  The returned MPFR value is entered in
-// the correct "slot" in coeffMPFR.
+// Called by CloseMPFR to free the cache of coefficients.  Contexts
+// hold copies, so any still open are not affected; a later context
+// makes its precision's entry again.
+// -------------------------------------------------------------------
+int FreeCoefficientCache(void)
+{
+struct coeffCache	*Cache;
+int					i, j;
+
+pthread_mutex_lock(&coeffLock);
+while((Cache = coeffCacheList) != NULL) {
+	coeffCacheList = Cache->Next;
+	for(i = 0; i < GABCKE_NUM_Cj_TERMS; i++) {
+		for(j = 0; j < GABCKE_COEFF_PER_Cj; j++) {
+			mpfr_clear (Cache->Coeff[i][j]);
+			}
+		}
+	free(Cache);
+	}
+pthread_mutex_unlock(&coeffLock);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Fill in the context's coefficient table at its precision.  The
+// values are copied from the cache (see CoeffCacheFind), which makes
+// them from coeffGabckeBinary the first time a precision is used.
+// If there is no memory for a cache entry, we make the context's
+// values from coeffGabckeBinary directly.  With the PRINT_COEFF debug flag, each value is printed, and checked
+// against the one CoeffStrToMPFR makes from the string in coeffGabcke.
 // -------------------------------------------------------------------
-int BuildCoefficientsMPFR(void)
+int BuildCoefficientsMPFR(struct HGT_CONTEXT *Context)
 {
-int		i, j;
-bool	Debug = DebugMode(hgt_init.DebugFlags, PRINT_COEFF);
+struct coeffCache	*Cache;
+mpfr_t				Check;
+int					i, j;
+bool				Debug = DebugMode(Context->Init.DebugFlags, PRINT_COEFF);
+
+pthread_mutex_lock(&coeffLock);
+Cache = CoeffCacheFind(Context->Init.DefaultBits);
+for(i = 0; i < GABCKE_NUM_Cj_TERMS; i++) {
+	for(j = 0; j < GABCKE_COEFF_PER_Cj; j++) {
+		if(Cache != NULL) {
+			mpfr_set (Context->Coeff[i][j], Cache->Coeff[i][j], MPFR_RNDN);
+			}
+		else {
+			CoeffBinToMPFR(&Context->Coeff[i][j], i, j);
+			}
+		}
+	}
+pthread_mutex_unlock(&coeffLock);
+if(Debug == false) {
+	return(1);
+	}
 
-for(i = 0; i < 5; i++)
+mpfr_init2 (Check, Context->Init.DefaultBits);
+for(i = 0; i < GABCKE_NUM_Cj_TERMS; i++)
 	{
-	if(Debug) {							
 	printf("-------------------- \n");
-		}	
 	for (j = 0; j < GABCKE_COEFF_PER_Cj; j++)
 		{
-		CoeffStrToMPFR(&coeffMPFR[i][j], coeffGabcke[i][j]);
-		if(Debug) {						
-			if(coeffGabcke[i][j][0] == '-') {
-			mpfr_printf("%.50Rf \n", coeffMPFR[i][j]);
-				}
-			else
-				{
-				mpfr_printf(" %.50Rf \n", coeffMPFR[i][j]);
-				}
+		if(coeffGabcke[i][j][0] == '-') {
+		mpfr_printf("%.50Rf \n", Context->Coeff[i][j]);
+			}
+		else
+			{
+			mpfr_printf(" %.50Rf \n", Context->Coeff[i][j]);
+			}
+		CoeffStrToMPFR(&Check, coeffGabcke[i][j]);
+		if(mpfr_equal_p (Check, Context->Coeff[i][j]) == 0) {
+			printf("Coefficient C%d[%d] does not match its string.\n", i, j);
 			}
 		}
 	}
+mpfr_clear (Check);
 return(1);	
 }
 
+// -------------------------------------------------------------------
+// Set Result to coefficient k of Cj, from coeffGabckeBinary: K is
+// made exactly at 192 bits, then divided by 10^50 (also exact at 192
+// bits), so the one rounding is that of the division.
+// -------------------------------------------------------------------
+int CoeffBinToMPFR(mpfr_t *Result, int Cj, int k)
+{
+const struct coeffBinary	*Bin = &coeffGabckeBinary[Cj][k];
+mpfr_t						K, Word, Scale;
+
+mpfr_inits2 (192, K, Word, Scale, (mpfr_ptr) 0);
+mpfr_set_uj (K, Bin->K[2], MPFR_RNDN);
+mpfr_mul_2ui (K, K, 64, MPFR_RNDN);
+mpfr_set_uj (Word, Bin->K[1], MPFR_RNDN);
+mpfr_add (K, K, Word, MPFR_RNDN);
+mpfr_mul_2ui (K, K, 64, MPFR_RNDN);
+mpfr_set_uj (Word, Bin->K[0], MPFR_RNDN);
+mpfr_add (K, K, Word, MPFR_RNDN);
+mpfr_ui_pow_ui (Scale, 10, GABCKE_DECIMAL_PLACES, MPFR_RNDN);
+mpfr_div (*Result, K, Scale, MPFR_RNDN);
+if(Bin->Sign < 0) {
+	mpfr_neg (*Result, *Result, MPFR_RNDN);
+	}
+mpfr_clears (K, Word, Scale, (mpfr_ptr) 0);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Find the cache entry for Bits, making it if there is none.  The 
+// caller holds coeffLock.  Returns NULL if we are out of memory.
+// -------------------------------------------------------------------
+static struct coeffCache * CoeffCacheFind(int Bits)
+{
+struct coeffCache	*Cache;
+int					i, j;
+
+for(Cache = coeffCacheList; Cache != NULL; Cache = Cache->Next) {
+	if(Cache->Bits == Bits) {
+		return(Cache);
+		}
+	}
+if((Cache = malloc(sizeof(struct coeffCache))) == NULL) {
+	return(NULL);
+	}
+Cache->Bits = Bits;
+for(i = 0; i < GABCKE_NUM_Cj_TERMS; i++) {
+	for(j = 0; j < GABCKE_COEFF_PER_Cj; j++) {
+		mpfr_init2 (Cache->Coeff[i][j], Bits);
+		CoeffBinToMPFR(&Cache->Coeff[i][j], i, j);
+		}
+	}
+Cache->Next	   = coeffCacheList;
+coeffCacheList = Cache;
+return(Cache);
+}
+
 // -------------------------------------------------------------------
 // As described in BuildCoefficientsMPFR, we convert the passed 
 // string (from coeffGabcke) to MPFR format.
@@ -1,10 +1,11 @@
 // -------------------------------------------------------------------
-// Program last modified January 9, 2026. 
+// Program last modified October 16, 2026. 
 // Copyright (c) 2024-2026 Terrence P. Murphy
 // MIT License -- see hgt.h for details.
 // -------------------------------------------------------------------
 
 #include <stdio.h>
+#include <math.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
@@ -14,17 +15,68 @@
 
 #include "hgt.h"
 
-extern struct	HGT_INIT	hgt_init;
 
+// -------------------------------------------------------------------
+// For large N, RS_MainTerm splits n = 1..N into blocks that are summed
+// by the worker pool.  The block size depends only on N (never on the
+// number of threads), and the block sums are combined in a fixed
+// pairwise tree, so the result is the same bit for bit however many
+// threads are used.
+// -------------------------------------------------------------------
+struct mainBlock {
+	mpfr_ptr	t;
+	mpfr_ptr	Theta;
+	mpfr_ptr	ThetaPrime;			// NULL unless we want the derivative
+	uint64_t	nFirst;
+	uint64_t	nLast;
+	uint64_t	nTable;				// table size wanted, 0 for no table
+	int			iFloatBits;
+	mpfr_t		Sum;
+	mpfr_t		DSum;				// used only with ThetaPrime
+};
+
+static int	RS_MainTermCore(mpfr_t *Result, mpfr_t *Deriv, mpfr_t t, uint64_t N,
+				int iFloatBits);
+static int	RS_MainTermRange(mpfr_t Sum, mpfr_ptr DSum, mpfr_t t, mpfr_t Theta,
+				mpfr_ptr ThetaPrime, uint64_t nFirst, uint64_t nLast, int iFloatBits,
+				const void *Table);
+static int	RS_MainTermSplit(mpfr_t Main, mpfr_ptr DMain, mpfr_t t, mpfr_t Theta,
+				mpfr_ptr ThetaPrime, uint64_t N, int iFloatBits, bool UseTable);
+static void	RS_MainBlockTask(void *Arg);
 
 // *******************************************************************
 // We compute the main term of the Riemann-Siegel formula.  
 // *******************************************************************
 int RS_MainTerm(mpfr_t *Result, mpfr_t t, uint64_t N, int iFloatBits)
 {
-mpfr_t		Theta, Temp1, Temp2;
-mpfr_t		Main, RecipSqrtn, CosArg, CosCalc, FullTerm, LognMinusOne;
-uint64_t	n;
+return(RS_MainTermCore(Result, NULL, t, N, iFloatBits));
+}
+
+// *******************************************************************
+// We compute the main term of the Riemann-Siegel formula and its
+// derivative in t, in the same pass.  The derivative of the term
+//		2 * sqrt(1/n) * cos[theta(t) - t log n]
+// is 
+//		-2 * sqrt(1/n) * sin[theta(t) - t log n] * [theta'(t) - log n]
+// so each term costs a sine (from the same mpfr_sin_cos call) and a 
+// multiply-add more.
+// *******************************************************************
+int RS_MainTermDeriv(mpfr_t *Result, mpfr_t *Deriv, mpfr_t t, uint64_t N, int iFloatBits)
+{
+return(RS_MainTermCore(Result, Deriv, t, N, iFloatBits));
+}
+
+// -------------------------------------------------------------------
+// The code for RS_MainTerm and RS_MainTermDeriv; Deriv may be NULL.
+// -------------------------------------------------------------------
+static int RS_MainTermCore(mpfr_t *Result, mpfr_t *Deriv, mpfr_t t, uint64_t N,
+	int iFloatBits)
+{
+struct HGT_WORKMARK	Mark;
+mpfr_t		Theta, Main, ThetaPrime, DMain;
+const void	*Table;
+uint64_t	Start;
+bool		UseTable;
 
 // -------------------------------------------------------------------
 // Check the case N < 1 (nothing to do so return 0 in Result).
@@ -32,76 +84,306 @@ uint64_t	n;
 if(N < 1)
 	{
 	mpfr_set_ui (*Result, 0, MPFR_RNDN);
+	if(Deriv != NULL) {
+		mpfr_set_ui (*Deriv, 0, MPFR_RNDN);
+		}
 	return(1);
 	}
 
 // -------------------------------------------------------------------
 // Initialize the MPFR variables.
 // -------------------------------------------------------------------
-mpfr_inits2 (iFloatBits, Theta, Temp1, Temp2, 
-	Main, RecipSqrtn, CosArg, CosCalc, FullTerm, LognMinusOne, (mpfr_ptr) 0);
+Mark = WorkMark();
+WorkInits(iFloatBits, Theta, Main, ThetaPrime, DMain, (mpfr_ptr) 0);
+
+// -------------------------------------------------------------------
+// Compute Theta (and, for the derivative, ThetaPrime).
+// -------------------------------------------------------------------
+Start = StatsStart();
+if(Deriv == NULL) {
+	ThetaOfTPrec(&Theta, t, iFloatBits);
+	}
+else {
+	ThetaPairOfT(&Theta, &ThetaPrime, t);
+	}
+StatsStop(HGT_STAGE_THETA, Start);
+Start = StatsStart();
 
 // -------------------------------------------------------------------
-// Compute Theta.
+// If a log(n) / 1/sqrt(n) table is open at this precision (see
+// hgtTable.c), read those values from it rather than compute them.
+// The fixed-point sum (see hgtFixed.c) has no use for the table.
+// For large N each block takes the table itself: the read lock must
+// not be held while we wait on the pool, since a block that grows the
+// table needs the write lock.
 // -------------------------------------------------------------------
-ThetaOfT(&Theta, t);
+UseTable = !(Deriv == NULL && FixedUsable(iFloatBits));
+Table = UseTable && N < HGT_MAIN_SPLIT_MIN 
+	? TableAcquire(HGT_BACKEND_MPFR, iFloatBits, N) : NULL;
 
 // -------------------------------------------------------------------
 // Loop n = 1 to N.  
 // For each n, we are calculating: sqrt(1/n) * cos[theta(t) - t log n]
 //
-// We will handle the n = 1 case separately before entering the loop.
+// For the n = 1 term, we set the initial value of Main to cos(theta)
+// (and of DMain to sin(theta) * theta'(t)).  Then we add the n = 2 
+// through n = N terms, in one loop or (for large N) in blocks on the
+// worker pool.
 // ------------------------------------------------------------------
+if(N < HGT_MAIN_SPLIT_MIN) {
+	mpfr_cos (Main, Theta, MPFR_RNDN); 
+	if(Deriv != NULL) {
+		mpfr_sin (DMain, Theta, MPFR_RNDN);
+		mpfr_mul (DMain, DMain, ThetaPrime, MPFR_RNDN);
+		}
+	RS_MainTermRange(Main, Deriv != NULL ? DMain : NULL, t, Theta,
+		Deriv != NULL ? ThetaPrime : NULL, 2, N, iFloatBits, Table);
+	}
+else {
+	RS_MainTermSplit(Main, Deriv != NULL ? DMain : NULL, t, Theta, 
+		Deriv != NULL ? ThetaPrime : NULL, N, iFloatBits, UseTable);
+	}
+
+if(Table != NULL) {
+	TableRelease(HGT_BACKEND_MPFR);
+	}
+StatsStop(HGT_STAGE_MAIN, Start);
+
 // -------------------------------------------------------------------
-// For the n = 1 term, we set the initial value of Main to cos(theta).
+// We have calculated Main.  Now, multiply by 2 and return result.
+// The derivative is -2 * DMain.
 // -------------------------------------------------------------------
-mpfr_cos (Main, Theta, MPFR_RNDN); 
+mpfr_mul_2ui (*Result, Main, 1, MPFR_RNDN);
+if(Deriv != NULL) {
+	mpfr_mul_2ui (*Deriv, DMain, 1, MPFR_RNDN);
+	mpfr_neg (*Deriv, *Deriv, MPFR_RNDN);
+	}
 
 // -------------------------------------------------------------------
-// Now process the n = 2 through n = N terms
+// Free the space used by the local mpfr (constant) variables
+// -------------------------------------------------------------------	
+WorkRelease(Mark);
+return(1);
+}
+
 // -------------------------------------------------------------------
-for (n = 2; n <= N; ++n) { 
-	// ---------------------------------------------------------------
-	// We need an mpfr_t version of n, so save in Temp1
-	// ---------------------------------------------------------------	
-	mpfr_set_uj (Temp1, n, MPFR_RNDN);
-	
-	// ---------------------------------------------------------------
-	// First, compute the square root of 1/n
-	// ---------------------------------------------------------------	
-	mpfr_rec_sqrt (RecipSqrtn, Temp1, MPFR_RNDN);	
+// A bound on the error in the value RS_MainTerm computes at iFloatBits
+// (unit roundoff u), for N terms.  Each MPFR operation is correctly
+// rounded, so:
+//	 (1) theta(t), about Theta = (t/2)(|log(t / (2 pi))| + 1) in size, 
+//		 is off by at most dTheta = 3 u t (|log(t / (2 pi))| + 1) + 4u, 
+//		 plus the terms its asymptotic series leaves out;
+//	 (2) the argument theta(t) - t log n of term n is then off by at 
+//		 most dTheta + u (4 t log N + Theta + 4), which also covers the
+//		 cosine, 1/sqrt(n) and their product;
+//	 (3) term n has weight n^{-1/2}, and SUM n^{-1/2} <= 2 sqrt(N);
+//	 (4) every partial sum is at most 2 sqrt(N) in size, so the N 
+//		 additions (in any order) add at most 2 u N^{3/2};
+//	 (5) terms summed in fixed point (see hgtFixed.c) are not rounded
+//		 by MPFR, but truncated at W >= iFloatBits / 64 + 1 limbs.  There
+//		 the error in log n, after at most 2^16 steps of at most 2^9 
+//		 units of 2^{-64 (W + 1)} each, times tau < 2^64, puts the phase
+//		 off by under 2^25 units of 2^{-64 W} turns, and the cosine,
+//		 1/sqrt(n), their product and the input conversions add under 
+//		 2^10 units more.  So each term is off by under 2^29 2^{-64 W},
+//		 which is at most 2^-35 u, or 2^-35 u N in all.
+// The result is twice the sum, so twice the bound.
+// -------------------------------------------------------------------
+double RS_MainTermBound(double t, uint64_t N, int iFloatBits)
+{
+double	u = ldexp(1.0, -iFloatBits);
+double	L, LogN, Theta, dTheta, Weight;
+
+L	   = fabs(log(t / (2.0 * M_PI))) + 1.0;
+LogN   = log((double) (N > 0 ? N : 1));
+Theta  = 0.5 * t * L + 1.0;
+dTheta = 3.0 * u * t * L + 4.0 * u + 62.0 / (80640.0 * pow(t, 5));
+if(t >= THETA_MAX_T_POWER3) {
+	dTheta += 7.0 / (5760.0 * pow(t, 3));
+	}
+Weight = 2.0 * sqrt((double) N);
+return(2.0 * (Weight * (dTheta + u * (4.0 * t * LogN + Theta + 4.0))
+	+ 2.0 * u * pow((double) N, 1.5) + ldexp(u * (double) N, -35)));
+}
+
+// -------------------------------------------------------------------
+// Add the terms n = nFirst..nLast of the main sum to Sum, in order.
+// If DSum is not NULL, also add sqrt(1/n) * sin[theta(t) - t log n]
+// * [theta'(t) - log n] to DSum.
+// -------------------------------------------------------------------
+static int RS_MainTermRange(mpfr_t Sum, mpfr_ptr DSum, mpfr_t t, mpfr_t Theta,
+	mpfr_ptr ThetaPrime, uint64_t nFirst, uint64_t nLast, int iFloatBits,
+	const void *Table)
+{
+struct HGT_WORKMARK	Mark;
+mpfr_t		Temp1, Temp2, RecipSqrtn, CosArg, CosCalc, FullTerm, SinCalc;
+mpfr_t		TabLog, TabRecip;			// views into the table (not init'ed)
+mpfr_ptr	pLog, pRecip;
+uint64_t	n;
+
+// -------------------------------------------------------------------
+// At up to 64 * HGT_FIXED_LIMBS_MAX bits, the sum (without the
+// derivative) is done in fixed point, with no MPFR calls per term.
+// -------------------------------------------------------------------
+if(DSum == NULL && Table == NULL 
+	&& MainSumFixed(Sum, t, Theta, nFirst, nLast, iFloatBits) == 1) {
+	if(nLast >= nFirst) {
+		StatsCount(HGT_STAT_TERMS, nLast - nFirst + 1);
+		}
+	return(1);
+	}
+
+Mark = WorkMark();
+WorkInits(iFloatBits, Temp1, Temp2, 
+	RecipSqrtn, CosArg, CosCalc, FullTerm, SinCalc, (mpfr_ptr) 0);
+
+for (n = nFirst; n <= nLast; ++n) { 
+	if(Table != NULL) {
+		TableViewMPFR(Table, n, TabLog, TabRecip);
+		pLog   = TabLog;
+		pRecip = TabRecip;
+		}
+	else {
+		// -----------------------------------------------------------
+		// We need an mpfr_t version of n, so save in Temp1
+		// -----------------------------------------------------------
+		mpfr_set_uj (Temp1, n, MPFR_RNDN);
+
+		// -----------------------------------------------------------
+		// First, compute the square root of 1/n, then log n
+		// -----------------------------------------------------------
+		mpfr_rec_sqrt (RecipSqrtn, Temp1, MPFR_RNDN);	
+		mpfr_log (FullTerm, Temp1, MPFR_RNDN);
+		pLog   = FullTerm;
+		pRecip = RecipSqrtn;
+		}
 
 	// ---------------------------------------------------------------
-	// Second, compute the argument to the cosine term.
+	// Next, compute the argument to the cosine term.
 	// That is, CosArg = [theta(t) - t log n].  
 	// Then (further below) compute cos(CosArg).
 	// ---------------------------------------------------------------	
-	mpfr_log (Temp2, Temp1, MPFR_RNDN);			// log n
-	mpfr_mul (Temp2, t, Temp2, MPFR_RNDN); 		// t * log n
+	mpfr_mul (Temp2, t, pLog, MPFR_RNDN); 		// t * log n
 	mpfr_sub (CosArg, Theta, Temp2, MPFR_RNDN); // theta(t) - [t * log n]	
 
 	//----------------------------------------------------------------
-	// We are now ready to compute the cosine value = CosCalc.
+	// We are now ready to compute the cosine value = CosCalc (and,
+	// for the derivative, the sine, and add its term to DSum).
 	//----------------------------------------------------------------
-	mpfr_cos (CosCalc, CosArg, MPFR_RNDN);
+	if(DSum == NULL) {
+		mpfr_cos (CosCalc, CosArg, MPFR_RNDN);
+		}
+	else {
+		mpfr_sin_cos (SinCalc, CosCalc, CosArg, MPFR_RNDN);
+		mpfr_sub (Temp1, ThetaPrime, pLog, MPFR_RNDN);
+		mpfr_mul (Temp1, Temp1, SinCalc, MPFR_RNDN);
+		mpfr_fma (DSum, pRecip, Temp1, DSum, MPFR_RNDN);
+		}
 	//----------------------------------------------------------------
 	// For the full term, multiply CosCalc by RecipSqrtn, then
-	// add to Main.
+	// add to Sum.
 	//----------------------------------------------------------------
-	mpfr_mul (FullTerm, RecipSqrtn, CosCalc, MPFR_RNDN);
-	mpfr_add (Main, Main, FullTerm, MPFR_RNDN);
+	mpfr_mul (Temp2, pRecip, CosCalc, MPFR_RNDN);
+	mpfr_add (Sum, Sum, Temp2, MPFR_RNDN);
 	} // end of for loop
 
 // -------------------------------------------------------------------
-// We have calculated Main.  Now, multiply by 2 and return result.
+// Count the terms, and the MPFR calls made for them (see hgtStats.c).
 // -------------------------------------------------------------------
-mpfr_mul_2ui (*Result, Main, 1, MPFR_RNDN);
+if(nLast >= nFirst) {
+	StatsCount(HGT_STAT_TERMS, nLast - nFirst + 1);
+	StatsCount(HGT_STAT_MPFR_OPS, (nLast - nFirst + 1) 
+		* ((Table != NULL ? 5 : 8) + (DSum != NULL ? 3 : 0)));
+	}
+
+WorkRelease(Mark);
+return(1);
+}
 
 // -------------------------------------------------------------------
-// Free the space used by the local mpfr (constant) variables
-// -------------------------------------------------------------------	
-mpfr_clears (Theta, Temp1, Temp2,  
-  Main, RecipSqrtn, CosArg, CosCalc, FullTerm, LognMinusOne, (mpfr_ptr) 0);
+// The main sum for large N.  Blocks hold HGT_MAIN_BLOCK terms (more,
+// if that would give over HGT_MAIN_MAX_BLOCKS blocks).  Block 0 starts
+// from cos(theta), the n = 1 term.
+// -------------------------------------------------------------------
+static int RS_MainTermSplit(mpfr_t Main, mpfr_ptr DMain, mpfr_t t, mpfr_t Theta,
+	mpfr_ptr ThetaPrime, uint64_t N, int iFloatBits, bool UseTable)
+{
+struct mainBlock	*blocks;
+struct HGT_BATCH	*Batch;
+uint64_t			Size, nBlocks, i, Step;
+
+Size = HGT_MAIN_BLOCK;
+if((N + Size - 1) / Size > HGT_MAIN_MAX_BLOCKS) {
+	Size = (N + HGT_MAIN_MAX_BLOCKS - 1) / HGT_MAIN_MAX_BLOCKS;
+	}
+nBlocks = (N + Size - 1) / Size;
+blocks	= malloc(nBlocks * sizeof(struct mainBlock));
+Batch	= PoolBatchCreate();
+
+for(i = 0; i < nBlocks; i++) {
+	blocks[i].t			 = t;
+	blocks[i].Theta		 = Theta;
+	blocks[i].ThetaPrime = (DMain != NULL) ? ThetaPrime : NULL;
+	blocks[i].nFirst	 = i * Size + 1;
+	blocks[i].nLast		 = (i + 1) * Size < N ? (i + 1) * Size : N;
+	blocks[i].nTable	 = UseTable ? N : 0;
+	blocks[i].iFloatBits = iFloatBits;
+	mpfr_inits2 (iFloatBits, blocks[i].Sum, blocks[i].DSum, (mpfr_ptr) 0);
+	PoolSubmit(Batch, RS_MainBlockTask, &blocks[i]);
+	}
+PoolWaitBatch(Batch);
+PoolBatchFree(Batch);
+
+// -------------------------------------------------------------------
+// Combine the block sums pairwise: after the pass with Step = s,
+// blocks[i] (i a multiple of 2s) holds the sum of blocks i..i+2s-1.
+// -------------------------------------------------------------------
+for(Step = 1; Step < nBlocks; Step *= 2) {
+	for(i = 0; i + Step < nBlocks; i += 2 * Step) {
+		mpfr_add (blocks[i].Sum, blocks[i].Sum, blocks[i + Step].Sum, MPFR_RNDN);
+		if(DMain != NULL) {
+			mpfr_add (blocks[i].DSum, blocks[i].DSum, blocks[i + Step].DSum, MPFR_RNDN);
+			}
+		}
+	}
+mpfr_set (Main, blocks[0].Sum, MPFR_RNDN);
+if(DMain != NULL) {
+	mpfr_set (DMain, blocks[0].DSum, MPFR_RNDN);
+	}
 
+for(i = 0; i < nBlocks; i++) {
+	mpfr_clears (blocks[i].Sum, blocks[i].DSum, (mpfr_ptr) 0);
+	}
+free(blocks);
 return(1);
 }
+
+// -------------------------------------------------------------------
+// The pool task for one block of the main sum.
+// -------------------------------------------------------------------
+static void RS_MainBlockTask(void *Arg)
+{
+struct mainBlock	*block = (struct mainBlock *) Arg;
+const void			*Table;
+
+Table = block->nTable > 0 
+	? TableAcquire(HGT_BACKEND_MPFR, block->iFloatBits, block->nTable) : NULL;
+if(block->nFirst == 1) {
+	mpfr_cos (block->Sum, block->Theta, MPFR_RNDN);
+	if(block->ThetaPrime != NULL) {
+		mpfr_sin (block->DSum, block->Theta, MPFR_RNDN);
+		mpfr_mul (block->DSum, block->DSum, block->ThetaPrime, MPFR_RNDN);
+		}
+	block->nFirst = 2;
+	}
+else {
+	mpfr_set_zero (block->Sum, 1);
+	mpfr_set_zero (block->DSum, 1);
+	}
+RS_MainTermRange(block->Sum, block->ThetaPrime != NULL ? block->DSum : NULL, 
+	block->t, block->Theta, block->ThetaPrime, block->nFirst, block->nLast, 
+	block->iFloatBits, Table);
+if(Table != NULL) {
+	TableRelease(HGT_BACKEND_MPFR);
+	}
+}
@@ -1,10 +1,11 @@
 // -------------------------------------------------------------------
-// Program last modified January 9, 2026. 
+// Program last modified October 16, 2026. 
 // Copyright (c) 2024-2026 Terrence P. Murphy
 // MIT License -- see hgt.h for details.
 // -------------------------------------------------------------------
 
 #include <stdio.h>
+#include <math.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
@@ -14,12 +15,11 @@
 
 #include "hgt.h"
 
-extern struct	HGT_INIT	hgt_init;
-
 
 // -------------------------------------------------------------------
 // In support of computing the remainder term of the Riemann-Siegel 
-// formula, we use a table from Gabcke (here "coeffMPFR"), where he 
+// formula, we use a table from Gabcke (held, at the context's 
+// precision, in the Coeff table of each context), where he 
 // computed power series coefficients of the first five Cj terms. 
 // As a reminder, each Cj is an entire function, with the C0, C2, 
 // and C4 terms even functions (only even coefficients are non-zero) 
@@ -30,113 +30,272 @@ extern struct	HGT_INIT	hgt_init;
 // With a leading (whole number) term of 0 or -0, the MPFR (256 bit) 
 // data type should be accurate to more than 70 decimal places.
 // -------------------------------------------------------------------
-extern mpfr_t	coeffMPFR[GABCKE_NUM_Cj_TERMS][GABCKE_COEFF_PER_Cj];
+
+// -------------------------------------------------------------------
+// The absolute values of the coefficients, as doubles.  RS_Remainder uses 
+// these to decide how many Cj terms, and how many coefficients of 
+// each Cj, it needs at a given t and precision.
+// -------------------------------------------------------------------
+static double	coeffAbs[GABCKE_NUM_Cj_TERMS][GABCKE_COEFF_PER_Cj];
+
+// -------------------------------------------------------------------
+// For each Cj, the sums over its coefficients of |c_k| and k |c_k|
+// (k being the power of AdjP).  RS_RemainderBound uses these to bound 
+// the rounding error in Cj and the change in Cj when AdjP is off.
+// -------------------------------------------------------------------
+static double	coeffSum[GABCKE_NUM_Cj_TERMS];
+static double	coeffDSum[GABCKE_NUM_Cj_TERMS];
+
+static int	RS_RemainderCore(mpfr_t *Result, mpfr_t *Deriv, mpfr_t tOver2Pi, 
+				bool nEven, mpfr_t P, int iFloatBits);
+
+// -------------------------------------------------------------------
+// Build coeffAbs (and coeffSum and coeffDSum) from 256-bit values, so
+// that it is the same for every context.  This is called (once) by 
+// InitCoeffMPFR.
+// -------------------------------------------------------------------
+int BuildRemainderBounds(void)
+{
+mpfr_t	Temp1;
+int		i, j;
+
+mpfr_init2 (Temp1, 256);
+for(j = 0; j < GABCKE_NUM_Cj_TERMS; j++) {
+	coeffSum[j]	 = 0;
+	coeffDSum[j] = 0;
+	for(i = 0; i < GABCKE_COEFF_PER_Cj; i++) {
+		CoeffBinToMPFR(&Temp1, j, i);
+		coeffAbs[j][i] = fabs(mpfr_get_d (Temp1, MPFR_RNDU));
+		coeffSum[j]	  += coeffAbs[j][i];
+		coeffDSum[j]  += coeffAbs[j][i] * (2 * i + j % 2);
+		}
+	}
+mpfr_clear (Temp1);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// For each Cj, find how many coefficients we need.  With 
+// x = AdjP^2 (so 0 <= x <= 1), the coefficients we drop from Cj 
+// add up to at most Scale * sum_{k >= m} |c_k| x^k, where Scale is 
+// tFraction^{2j}.  We keep the smallest m for which that bound is 
+// below Tol (m = 0 means we may drop Cj altogether).
+// -------------------------------------------------------------------
+static void RS_RemainderCounts(int Counts[GABCKE_NUM_Cj_TERMS], double AdjP2, 
+		double tFraction2, double Tol)
+{
+double	Powers[GABCKE_COEFF_PER_Cj];
+double	Scale, Tail;
+int		i, j;
+
+Powers[0] = 1;
+for(i = 1; i < GABCKE_COEFF_PER_Cj; i++) {
+	Powers[i] = Powers[i - 1] * AdjP2;
+	}
+
+for(j = 0, Scale = 1; j < GABCKE_NUM_Cj_TERMS; j++, Scale *= tFraction2) {
+	Tail	  = 0;
+	Counts[j] = 0;
+	for(i = GABCKE_COEFF_PER_Cj - 1; i >= 0; i--) {
+		Tail += coeffAbs[j][i] * Powers[i];
+		if(Scale * Tail >= Tol) {
+			Counts[j] = i + 1;
+			break;
+			}
+		}
+	}
+}
 
 // -------------------------------------------------------------------
 // The function computes a remainder FACTOR and a remainder 
 // SUM, and then returns the product of FACTOR * SUM.
+//
+// Only the Cj terms and coefficients that can change the SUM by
+// Tol or more are used (see RS_RemainderCounts); as t grows, the 
+// higher Cj terms drop out.  Tol is 2^{-(iFloatBits + 4)}, but no 
+// smaller than GABCKE_REMAINDER_TOL: the Gabcke coefficients are 
+// only given to 50 decimal places, so terms below that level do not
+// make the SUM more accurate.  Each Cj is evaluated
+// by Horner's rule in AdjP^2.
 // -------------------------------------------------------------------
 int RS_Remainder(mpfr_t *Result, mpfr_t tOver2Pi, 
 		bool nEven, mpfr_t P, int iFloatBits)
 {
-mpfr_t		tFraction, Factor, Total, Temp1, Temp2, AdjP, Cj;
-mpfr_t		PowersOfP[GABCKE_NUM_POWERS_P];
-unsigned int	j;
+return(RS_RemainderCore(Result, NULL, tOver2Pi, nEven, P, iFloatBits));
+}
 
 // -------------------------------------------------------------------
-// initialize all mpfr_t variables
+// As RS_Remainder, but also compute the derivative in t.  Writing
+// tFraction = tau = (t/(2 pi))^{-1/4} and AdjP = x, the remainder is 
+//		R = (-1)^{N-1} SUM_j Cj(x) tau^{2j+1}
+// with d tau/dt = -tau/(4t) and dx/dt = -tau^2/(2 pi), so
+//		R' = (-1)^N tau SUM_j tau^{2j} [Cj'(x) tau^2/(2 pi) 
+//				+ (2j + 1) Cj(x)/(4t)].
+// Horner's rule gives each Cj'(x) along with Cj(x).
+// -------------------------------------------------------------------
+int RS_RemainderDeriv(mpfr_t *Result, mpfr_t *Deriv, mpfr_t tOver2Pi, 
+		bool nEven, mpfr_t P, int iFloatBits)
+{
+return(RS_RemainderCore(Result, Deriv, tOver2Pi, nEven, P, iFloatBits));
+}
+
+// -------------------------------------------------------------------
+// A bound on the difference between the value RS_Remainder computes
+// (at iFloatBits) and the exact sum of the C0..C4 terms, for 
+// t / (2 pi) = tOver2Pi.  With tau = tOver2Pi^{-1/4}, it is tau times
+//	 (1) the coefficients dropped by RS_RemainderCounts, at most Tol
+//		 for each Cj;
+//	 (2) the error in the Gabcke coefficients (given to 50 places, and
+//		 stopping after GABCKE_COEFF_PER_Cj), GABCKE_TABLE_ERROR;
+//	 (3) rounding in Horner's rule, at most (2m + 16) u SUM |c_k| 
+//		 tau^{2j} with m coefficients and unit roundoff u; and
+//	 (4) the error in AdjP, which comes from the error in 
+//		 sqrt(t / (2 pi)), times SUM k |c_k| tau^{2j}.
+// -------------------------------------------------------------------
+double RS_RemainderBound(double tOver2Pi, int iFloatBits)
+{
+double	u = ldexp(1.0, -iFloatBits);
+double	Tol, tFraction, Scale, Sum = 0, DSum = 0, Table = 0, dAdjP;
+int		j;
+
+Tol = ldexp(1.0, -(iFloatBits + 4));
+if(Tol < GABCKE_REMAINDER_TOL) {
+	Tol = GABCKE_REMAINDER_TOL;
+	}
+tFraction = pow(tOver2Pi, -0.25);
+for(j = 0, Scale = 1; j < GABCKE_NUM_Cj_TERMS; j++, Scale *= tFraction * tFraction) {
+	Sum	  += Scale * coeffSum[j];
+	DSum  += Scale * coeffDSum[j];
+	Table += Scale * GABCKE_TABLE_ERROR;
+	}
+dAdjP = 4.0 * u * sqrt(tOver2Pi) + u;
+return(tFraction * (GABCKE_NUM_Cj_TERMS * Tol + Table 
+	+ (2 * GABCKE_COEFF_PER_Cj + 16) * u * Sum + DSum * dAdjP));
+}
+
+// -------------------------------------------------------------------
+// The code for RS_Remainder and RS_RemainderDeriv; Deriv may be NULL.
 // -------------------------------------------------------------------
-mpfr_inits2 (iFloatBits, 
-		tFraction, Factor, Total, Temp1, Temp2, AdjP, Cj, (mpfr_ptr) 0);	
+static int RS_RemainderCore(mpfr_t *Result, mpfr_t *Deriv, mpfr_t tOver2Pi, 
+		bool nEven, mpfr_t P, int iFloatBits)
+{
+struct HGT_WORKMARK	Mark;
+mpfr_t		tFraction, tFraction2, tPower, Total, AdjP, AdjP2, Cj;
+mpfr_t		DCj, DTotal, Temp1, Temp2;
+double		Tol;
+int			Counts[GABCKE_NUM_Cj_TERMS];
+int			i, j;
+uint64_t	Start = StatsStart();
 
-for(j = 0; j < GABCKE_NUM_POWERS_P; j++)	// init all P powers slots
-	{
-	mpfr_init2 (PowersOfP[j], iFloatBits);	// note: singular "init"
-	}	
+// -------------------------------------------------------------------
+// initialize all mpfr_t variables
+// -------------------------------------------------------------------
+Mark = WorkMark();
+WorkInits(iFloatBits, 
+		tFraction, tFraction2, tPower, Total, AdjP, AdjP2, Cj, (mpfr_ptr) 0);	
+WorkInits(iFloatBits, DCj, DTotal, Temp1, Temp2, (mpfr_ptr) 0);	
 
 // ---------------------------------------------------------------
 // Compute // t/(2* pi)]^{-1/4}.  We use the "square root of the 
 // reciprocal and then the square root" method.
 // ---------------------------------------------------------------	
-mpfr_rec_sqrt (tFraction, tOver2Pi, MPFR_RNDN);
-mpfr_sqrt (tFraction, tFraction, MPFR_RNDN);
-
-// -------------------------------------------------------------------
-// Compute FACTOR = tFraction * (-1)^{N - 1}
-// -------------------------------------------------------------------
-mpfr_set (Factor, tFraction, MPFR_RNDN);
-if(nEven == true) {
-	mpfr_neg (Factor, Factor, MPFR_RNDN);
-	}
+mpfr_rec_sqrt (tFraction2, tOver2Pi, MPFR_RNDN);
+mpfr_sqrt (tFraction, tFraction2, MPFR_RNDN);
 
 // -------------------------------------------------------------------
 // We next compute the SUM. Before we start, we must deal with P.
 //
 // Due to the construction of the table of coefficients, we need
-// to adjust P, with AdjP = 1 - (2 * P). Also, in the SUM formula, 
-// we will need to compute AdjP to powers 0 through 87, most of them 
-// multiple times.  For efficiency, we will do the computations 
-// once and store the results for later use.
+// to adjust P, with AdjP = 1 - (2 * P).  The Cj are polynomials in
+// AdjP^2 (times AdjP, for odd j), so we also compute AdjP2 = AdjP^2.
 // -------------------------------------------------------------------
-	// Compute AdjP = 1 - (2 * P).
 mpfr_mul_ui (AdjP, P, (unsigned long int) 2, MPFR_RNDN);
 mpfr_ui_sub (AdjP, (unsigned long int) 1, AdjP, MPFR_RNDN);
+mpfr_sqr (AdjP2, AdjP, MPFR_RNDN);
 
-	// initialize the PowersOfP[0] slot; AdjP^{0} = 1
-mpfr_init_set_ui (PowersOfP[0], (unsigned long int) 1, MPFR_RNDN);
-	
-	// Compute and save AdjP^{1} through AdjP^{87}
-for(unsigned int k=1; k < GABCKE_NUM_POWERS_P; k++) {
-	mpfr_mul (PowersOfP[k], PowersOfP[k-1], AdjP, MPFR_RNDN);
+Tol = ldexp(1.0, -(iFloatBits + 4));
+if(Tol < GABCKE_REMAINDER_TOL) {
+	Tol = GABCKE_REMAINDER_TOL;
 	}
+RS_RemainderCounts(Counts, mpfr_get_d (AdjP2, MPFR_RNDU), 
+	mpfr_get_d (tFraction2, MPFR_RNDU), Tol);
 
 // -------------------------------------------------------------------
 // We are now ready to compute the SUM by adding the individual Cj 
 // terms. The j-loop is over the 5 individual Cj terms. Inside the
-// j-loop, the i-loop is over the Gabcke coefficients for the
-// given Cj.  If j is even, Cj is an even function and the
+// j-loop, the i-loop runs Horner's rule over the Gabcke coefficients
+// for the given Cj.  If j is even, Cj is an even function and the
 // coefficients go in power series slots 0, 2,...; if j is odd, 
-// they go in power series slots 1, 3,...
-// After computing each Cj, we multiply that Cj by tFraction^{2j}
-// and add that value to the Total value.
+// they go in power series slots 1, 3,... (so we multiply by AdjP).
+// Each Cj is multiplied by tPower = tFraction^{2j} and added to 
+// Total.
+//
+// For the derivative, DCj is first the derivative of the polynomial
+// in AdjP^2, then Cj'(AdjP) multiplied by tau^2/(2 pi); DTotal sums
+// tPower * [DCj + (2j + 1) Cj/(4t)].
 // -------------------------------------------------------------------
-unsigned int	i, uiEvenOdd, uiPowersJ;
-
 mpfr_set_zero (Total, 1);	// Start with a Total of zero
+mpfr_set_zero (DTotal, 1);
+mpfr_set_ui (tPower, 1, MPFR_RNDN);
+
+for(j = 0; j < GABCKE_NUM_Cj_TERMS; j++) {
+	if(Counts[j] > 0) {
+		mpfr_set (Cj, hgt_current->Coeff[j][Counts[j] - 1], MPFR_RNDN);
+		mpfr_set_zero (DCj, 1);
+		for(i = Counts[j] - 2; i >= 0; i--) {
+			if(Deriv != NULL) {
+				mpfr_fma (DCj, DCj, AdjP2, Cj, MPFR_RNDN);
+				}
+			mpfr_mul (Cj, Cj, AdjP2, MPFR_RNDN);
+			mpfr_add (Cj, Cj, hgt_current->Coeff[j][i], MPFR_RNDN);
+			}
+		if(Deriv != NULL) {
+			if(j % 2 == 1) {						// Cj' = p + 2 x^2 p'
+				mpfr_mul (DCj, DCj, AdjP2, MPFR_RNDN);
+				mpfr_mul_2ui (DCj, DCj, 1, MPFR_RNDN);
+				mpfr_add (DCj, DCj, Cj, MPFR_RNDN);
+				}
+			else {									// Cj' = 2 x p'
+				mpfr_mul (DCj, DCj, AdjP, MPFR_RNDN);
+				mpfr_mul_2ui (DCj, DCj, 1, MPFR_RNDN);
+				}
+			}
+		if(j % 2 == 1) {
+			mpfr_mul (Cj, Cj, AdjP, MPFR_RNDN);
+			}
+		mpfr_fma (Total, tPower, Cj, Total, MPFR_RNDN);
+
+		if(Deriv != NULL) {
+			mpfr_mul (DCj, DCj, tFraction2, MPFR_RNDN);
+			mpfr_div (DCj, DCj, hgt_init.my2Pi, MPFR_RNDN);
+			mpfr_mul_ui (Temp1, Cj, 2 * j + 1, MPFR_RNDN);
+			mpfr_mul (Temp2, tOver2Pi, hgt_init.my2Pi, MPFR_RNDN);
+			mpfr_mul_2ui (Temp2, Temp2, 2, MPFR_RNDN);	// 4t
+			mpfr_div (Temp1, Temp1, Temp2, MPFR_RNDN);
+			mpfr_add (DCj, DCj, Temp1, MPFR_RNDN);
+			mpfr_fma (DTotal, tPower, DCj, DTotal, MPFR_RNDN);
+			}
+		}
+	mpfr_mul (tPower, tPower, tFraction2, MPFR_RNDN);
+	}
+
+// -------------------------------------------------------------------
+// Multiply by FACTOR = tFraction * (-1)^{N - 1}, and save in the 
+// passed Result variable.
+// -------------------------------------------------------------------
+mpfr_mul (*Result, Total, tFraction, MPFR_RNDN);
+if(nEven == true) {
+	mpfr_neg (*Result, *Result, MPFR_RNDN);
+	}
+
+if(Deriv != NULL) {
+	mpfr_mul (*Deriv, DTotal, tFraction, MPFR_RNDN);
+	if(nEven == false) {
+		mpfr_neg (*Deriv, *Deriv, MPFR_RNDN);
+		}
+	}
 
-	////////////////////////////////////
-	// Outer loop calculates a Cj term 
-	////////////////////////////////////
-for(j=0, uiPowersJ = 0; j < GABCKE_NUM_Cj_TERMS; j++, uiPowersJ += 2) {
-	// we are beginning a new Cj term, so set Cj = 0
-	mpfr_set_zero (Cj, 1);
-		//////////////////////////////////////////////////////////////////
-		// Inner loop is through the non-zero coefficients of this Cj term
-		//////////////////////////////////////////////////////////////////
-	for(i=0; i < GABCKE_COEFF_PER_Cj; i++) {
-		// Determine if non-zero coefficients are in even or odd slots 
-		uiEvenOdd = (j % 2);
-		// Multiply the correct AdjP power by the correct coefficient; save in Temp1
-		mpfr_mul (Temp1, PowersOfP[(2 * i) + uiEvenOdd], coeffMPFR[j][i], MPFR_RNDN);
-		// Add the saved Temp1 valur to Cj 
-		mpfr_add (Cj, Cj, Temp1, MPFR_RNDN);
-		} // end of inner loop 
-	// back to the outer loop; set Temp1 to tFraction^{uiPowersJ} 
-	mpfr_pow_ui (Temp1, tFraction, uiPowersJ, MPFR_RNDN);
-	// Multiply Cj by Temp1 and again save in Temp1 
-	mpfr_mul (Temp1, Temp1, Cj, MPFR_RNDN);
-	// Add Temp1 to Total and go to the top of the outer loop 
-	mpfr_add (Total, Total, Temp1, MPFR_RNDN);
-	} // end of outer loop 
-
-	// After exiting the outer loop, save Total in the passed Result variable
-mpfr_mul (*Result, Total, Factor, MPFR_RNDN);
-	// Clear the MPFR variables 
-mpfr_clears (tFraction, Factor, Total, Temp1, Temp2, AdjP, Cj, (mpfr_ptr) 0);	
-	
-for(j = 0; j < GABCKE_NUM_POWERS_P; j++)	// clear all P powers slots
-	{
-	mpfr_clear (PowersOfP[j]);				// Note singular "clear"
-	}		
+WorkRelease(Mark);
+StatsStop(HGT_STAGE_REMAINDER, Start);
 return(1);
 }
@@ -1,5 +1,5 @@
 // -------------------------------------------------------------------
-// Program last modified January 9, 2026. 
+// Program last modified October 16, 2026. 
 // Copyright (c) 2025-2026 Terrence P. Murphy
 // MIT License -- see hgt.h for details.
 // -------------------------------------------------------------------
@@ -14,7 +14,7 @@
 
 #include "hgt.h"
 
-extern struct	HGT_INIT	hgt_init;
+static int	ThetaSeries(mpfr_t *Theta, mpfr_t *ThetaPrime, mpfr_t t, int iFloatBits);
 
 // -------------------------------------------------------------------
 // We compute \theta(t) as used in the Riemann-Siegel formula.  
@@ -33,14 +33,88 @@ extern struct	HGT_INIT	hgt_init;
 // -------------------------------------------------------------------
 int ThetaOfT(mpfr_t *Theta, mpfr_t t)
 {
+return(ThetaOfTPrec(Theta, t, hgt_init.DefaultBits));
+}
+
+// -------------------------------------------------------------------
+// As ThetaOfT, with the working precision iFloatBits rather than the
+// default (see SelectPrecision).
+// -------------------------------------------------------------------
+int ThetaOfTPrec(mpfr_t *Theta, mpfr_t t, int iFloatBits)
+{
+return(ThetaSeries(Theta, NULL, t, iFloatBits));
+}
+
+// -------------------------------------------------------------------
+// We compute \theta'(t), the derivative of the \theta(t) formula 
+// used in ThetaOfT:
+//
+// ThetaPrime = (1/2) * log(t / (2 * PI)) - 1/(48 * t^2) 
+//		- 7/(1920 * t^4)
+//
+// with the last term dropped when ThetaOfT drops its Power3Term.
+// GramAtN uses this for its Newton steps.
+// -------------------------------------------------------------------
+int ThetaPrimeOfT(mpfr_t *ThetaPrime, mpfr_t t)
+{
+struct HGT_WORKMARK	Mark;
+mpfr_t		Temp1, Temp2;
+
+Mark = WorkMark();
+WorkInits(hgt_init.DefaultBits, Temp1, Temp2, (mpfr_ptr) 0);
+
+// (1/2) * log(t / (2 * PI))
+mpfr_div (Temp1, t, hgt_init.myPi, MPFR_RNDN);
+mpfr_div_ui (Temp1, Temp1, 2, MPFR_RNDN);
+mpfr_log (Temp1, Temp1, MPFR_RNDN);
+mpfr_div_ui (Temp1, Temp1, 2, MPFR_RNDN);
+
+// - 1/(48 * t^2)
+mpfr_sqr (Temp2, t, MPFR_RNDN);
+mpfr_mul_ui (Temp2, Temp2, 48, MPFR_RNDN);
+mpfr_ui_div (Temp2, 1, Temp2, MPFR_RNDN);
+mpfr_sub (Temp1, Temp1, Temp2, MPFR_RNDN);
+
+// - 7/(1920 * t^4)
+if(mpfr_cmp_d (t, THETA_MAX_T_POWER3) < 0)
+	{
+	mpfr_pow_si (Temp2, t, -4, MPFR_RNDN);
+	mpfr_mul_ui (Temp2, Temp2, 7, MPFR_RNDN);
+	mpfr_div_ui (Temp2, Temp2, 1920, MPFR_RNDN);
+	mpfr_sub (Temp1, Temp1, Temp2, MPFR_RNDN);
+	}
+
+mpfr_set (*ThetaPrime, Temp1, MPFR_RNDN);
+WorkRelease(Mark);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// We compute both \theta(t) (exactly as ThetaOfT does) and \theta'(t)
+// (as ThetaPrimeOfT does), sharing the log(t / (2 * PI)).  This is 
+// for the Newton steps of GramAtN and GramRange, which need both at 
+// the same t.
+// -------------------------------------------------------------------
+int ThetaPairOfT(mpfr_t *Theta, mpfr_t *ThetaPrime, mpfr_t t)
+{
+return(ThetaSeries(Theta, ThetaPrime, t, hgt_init.DefaultBits));
+}
+
+// -------------------------------------------------------------------
+// The code for ThetaOfTPrec and ThetaPairOfT; ThetaPrime may be NULL.
+// -------------------------------------------------------------------
+static int ThetaSeries(mpfr_t *Theta, mpfr_t *ThetaPrime, mpfr_t t, int iFloatBits)
+{
+struct HGT_WORKMARK	Mark;
 mpfr_t		tOver2, PiOver8, LogOftOver2Pi;
-mpfr_t		Recip48t, Power3Term, Temp1, MinorTerms;
+mpfr_t		Recip48t, Power3Term, Temp1, MinorTerms, Prime;
 
 // -------------------------------------------------------------------
 // initialize all mpfr_t variables used in computing Theta
 // -------------------------------------------------------------------
-mpfr_inits2 (hgt_init.DefaultBits, tOver2, PiOver8, LogOftOver2Pi, 
-	Recip48t, Power3Term, Temp1, MinorTerms, (mpfr_ptr) 0);
+Mark = WorkMark();
+WorkInits(iFloatBits, tOver2, PiOver8, LogOftOver2Pi, 
+	Recip48t, Power3Term, Temp1, MinorTerms, Prime, (mpfr_ptr) 0);
 
 // set tOver2
 mpfr_div_ui (tOver2, t, 2, MPFR_RNDN);
@@ -56,6 +130,15 @@ mpfr_div_ui (PiOver8, hgt_init.myPi, 8,  MPFR_RNDN);
 mpfr_mul_ui (Temp1, t, 48, MPFR_RNDN);
 mpfr_ui_div (Recip48t, 1, Temp1, MPFR_RNDN);
 
+// -------------------------------------------------------------------
+// Prime = (1/2) * LogOftOver2Pi - Recip48t / t [- 7/(1920 * t^4)]
+// -------------------------------------------------------------------
+if(ThetaPrime != NULL) {
+	mpfr_div_ui (Prime, LogOftOver2Pi, 2, MPFR_RNDN);
+	mpfr_div (Temp1, Recip48t, t, MPFR_RNDN);
+	mpfr_sub (Prime, Prime, Temp1, MPFR_RNDN);
+	}
+
 // -------------------------------------------------------------------
 // Compute the minor terms in the \theta(t) formula:
 //    MinorTerms = Recip48t - PiOver8 + Power3Term
@@ -73,6 +156,11 @@ if(mpfr_cmp_d (t, THETA_MAX_T_POWER3) < 0)
 	mpfr_mul_ui (Temp1, Temp1, 7, MPFR_RNDN);
 	mpfr_div_ui (Power3Term, Temp1, 5760, MPFR_RNDN);
 	mpfr_add (MinorTerms, MinorTerms, Power3Term, MPFR_RNDN);
+	if(ThetaPrime != NULL) {
+		mpfr_div (Temp1, Power3Term, t, MPFR_RNDN);		// 7/(5760 * t^4)
+		mpfr_mul_ui (Temp1, Temp1, 3, MPFR_RNDN);
+		mpfr_sub (Prime, Prime, Temp1, MPFR_RNDN);
+		}
 	}
 
 // -------------------------------------------------------------------
@@ -81,11 +169,13 @@ if(mpfr_cmp_d (t, THETA_MAX_T_POWER3) < 0)
 mpfr_sub_ui (Temp1, LogOftOver2Pi, 1, MPFR_RNDN);
 mpfr_mul (Temp1, tOver2, Temp1, MPFR_RNDN);
 mpfr_add (*Theta, Temp1, MinorTerms, MPFR_RNDN);	
+if(ThetaPrime != NULL) {
+	mpfr_set (*ThetaPrime, Prime, MPFR_RNDN);
+	}
 
 // -------------------------------------------------------------------
 // Free the space used by the local mpfr (constant) variables
 // -------------------------------------------------------------------	
-mpfr_clears ( tOver2, PiOver8, LogOftOver2Pi, 
-	Recip48t, Power3Term, Temp1, MinorTerms, (mpfr_ptr) 0);
+WorkRelease(Mark);
 return(1);
-}
\ No newline at end of file
+}
@@ -0,0 +1,475 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file uses Turing's method to check the zeros of Z(t) between
+// two Gram points, g_a and g_b (b = a + Count).
+//
+// Write N(t) = theta(t)/pi + 1 + S(t), where N(t) counts the zeros
+// of zeta with 0 < Im(s) <= t.  Trudgian (2011) showed that for
+// 168 pi < t1 < t2,
+//
+//		| integral_{t1}^{t2} S(t) dt | <= B(t2) = 2.067 + 0.059 log t2.
+//
+// After g_b, N(t) >= N(g_b) + L(t), where L(t) is the number of sign
+// changes of Z found in (g_b, t].  So, over the m Gram intervals
+// [g_b, g_{b+m}] (m = GramPts) of total length len,
+//
+//		N(g_b) - b - 1 <= (B - int L + int (theta/pi - b)) / len.
+//
+// In the same way, before g_a (with L'(t) the sign changes found in
+// (t, g_a]),
+//
+//		N(g_a) - a - 1 >= (-B + int L' + int (theta/pi - a)) / len.
+//
+// We know only that each zero lies between the two points where Z
+// changes sign, so we take the end of that interval that gives the
+// smaller integral of L (or L').  The integral of theta is done in
+// closed form (ThetaIntegral), with a bound on what its asymptotic 
+// series leaves out, and every step of the bound is rounded the safe
+// way.  When the first bound is below 1 and
+// the second above -1, N(g_b) <= b + 1 and N(g_a) >= a + 1; if we
+// have also found b - a sign changes between g_a and g_b, then every
+// zero there is simple and on the critical line, and N(g_b) = b + 1.
+//
+// Sign changes are found from Z at the Gram points.  Between two
+// good Gram points ((-1)^n Z(g_n) > 0) is a Gram block; when we find
+// fewer sign changes in a block than it has Gram intervals, we split
+// each of its Gram intervals into SubIntvl pieces and look again.  A
+// block that still comes up short fails Rosser's rule, and is counted
+// in BadBlocks.  Each Z value is computed once (as a pool task) and
+// used for both Gram intervals on either side of it.  Each comes with
+// a proven radius (see HardyZSingleBall), and we count a sign change
+// only between two values whose signs are certain (see TuringSign),
+// passing over any value whose ball contains zero.  The Gram 
+// intervals on either side of such a value are split, so the sign
+// changes near it are still found.  Passing over a value can only
+// lose sign changes, which makes the result less likely to be 
+// verified, never wrongly verified.
+// -------------------------------------------------------------------
+
+struct turingRun {
+	struct computeHZ	*gram;		// g_{a-m} ... g_{b+m}, with Z
+	struct computeHZ	**sub;		// per Gram interval: SubIntvl - 1 points, or NULL
+	struct computeHZ	*subPts;	// all of the sub points
+	uint64_t			nGram;
+	uint64_t			nSub;
+	int					SubIntvl;
+};
+
+static void		TuringZTask(void *Arg);
+static int		TuringSign(struct computeHZ *pt);
+static int		TuringEvaluate(struct computeHZ *pts, uint64_t Count);
+static uint64_t	TuringChanges(struct turingRun *run, uint64_t i, mpfr_t Sum,
+					mpfr_t Ref, int Mode);
+static int		TuringSubdivide(struct turingRun *run, bool *Flags, int GramPts,
+					uint64_t *BadBlocks);
+static int		ThetaIntegral(mpfr_t *Result, mpfr_t t, mpfr_rnd_t Rnd);
+static double	TuringBound(struct turingRun *run, uint64_t First, uint64_t Last,
+					mpfr_t nRef, int Side);
+
+// *******************************************************************
+// Check the zeros between g_N and g_{N+Count}, with GramPts Gram
+// intervals on each side for Turing's method and SubIntvl pieces per
+// Gram interval when a Gram block needs a closer look.  We return 1
+// (with the results in *Result), or -1 if the arguments are out of
+// range or g_{N-GramPts} is not above 168 pi.
+// *******************************************************************
+int TuringVerify(mpfr_t N, uint64_t Count, int GramPts, int SubIntvl,
+	struct HGT_TURING *Result)
+{
+struct turingRun	run;
+mpfr_t				nFirst, nRef, Accuracy, Temp1;
+mpfr_t				*gT;
+bool				*Flags;
+bool				bEven;
+uint64_t			i;
+
+memset(Result, 0, sizeof(struct HGT_TURING));
+if(Count < 1 || GramPts < 1 || SubIntvl < 2) {
+	return(-1);
+	}
+mpfr_inits2 (mpfr_get_prec(N) + 64, nFirst, nRef, (mpfr_ptr) 0);
+mpfr_sub_ui (nFirst, N, GramPts, MPFR_RNDN);
+if(mpfr_cmp_si (nFirst, 3) < 0) {
+	mpfr_clears (nFirst, nRef, (mpfr_ptr) 0);
+	return(-1);
+	}
+mpfr_inits2 (hgt_init.DefaultBits, Accuracy, Temp1, (mpfr_ptr) 0);
+
+// -------------------------------------------------------------------
+// Step 1.  The Gram points g_{N-GramPts} ... g_{N+Count+GramPts}, to
+// half the working precision.
+// -------------------------------------------------------------------
+run.nGram	 = Count + 2 * (uint64_t) GramPts + 1;
+run.SubIntvl = SubIntvl;
+run.subPts	 = NULL;
+run.nSub	 = 0;
+run.gram	 = malloc(run.nGram * sizeof(struct computeHZ));
+run.sub		 = calloc(run.nGram, sizeof(struct computeHZ *));
+Flags		 = malloc(run.nGram * sizeof(bool));
+gT			 = malloc(run.nGram * sizeof(mpfr_t));
+
+for(i = 0; i < run.nGram; i++) {
+	mpfr_init2 (gT[i], hgt_init.DefaultBits);
+	}
+mpfr_set_ui (Accuracy, 1, MPFR_RNDN);
+mpfr_div_2ui (Accuracy, Accuracy, hgt_init.DefaultBits / 2, MPFR_RNDN);
+GramRange(gT, nFirst, run.nGram, Accuracy);
+
+for(i = 0; i < run.nGram; i++) {
+	mpfr_inits2 (hgt_init.DefaultBits, run.gram[i].t, run.gram[i].Result, (mpfr_ptr) 0);
+	mpfr_swap (run.gram[i].t, gT[i]);
+	mpfr_clear (gT[i]);
+	}
+free(gT);
+
+mpfr_mul_ui (Temp1, hgt_init.myPi, HGT_TUR_T_MIN_PI, MPFR_RNDN);
+if(mpfr_cmp (run.gram[0].t, Temp1) > 0) {
+	// ---------------------------------------------------------------
+	// Step 2.  Z at every Gram point, then a closer look at the Gram
+	// blocks that come up short.  Gram point i is g_k, k = N - GramPts
+	// + i, and is good if (-1)^k Z(g_k) > 0.
+	// ---------------------------------------------------------------
+	TuringEvaluate(run.gram, run.nGram);
+	mpfr_div_2ui (Temp1, nFirst, 1, MPFR_RNDN);
+	bEven = mpfr_integer_p (Temp1) != 0;
+	for(i = 0; i < run.nGram; i++) {
+		Flags[i] = TuringSign(&run.gram[i]) * ((bEven == (i % 2 == 0)) ? 1 : -1) > 0;
+		}
+	Result->Evaluations = run.nGram + TuringSubdivide(&run, Flags, GramPts, &Result->BadBlocks);
+
+	// ---------------------------------------------------------------
+	// Step 3.  Count the sign changes between g_a and g_b, and apply
+	// Turing's method after g_b and before g_a.
+	// ---------------------------------------------------------------
+	for(i = GramPts; i < GramPts + Count; i++) {
+		Result->Zeros += TuringChanges(&run, i, NULL, NULL, 0);
+		}
+	mpfr_set_uj (nRef, Count, MPFR_RNDN);
+	mpfr_add (nRef, nRef, N, MPFR_RNDN);
+	Result->UpperExcess = TuringBound(&run, GramPts + Count, run.nGram - 1, nRef, 1);
+	Result->LowerExcess = TuringBound(&run, 0, GramPts, N, -1);
+	Result->Verified	= Result->LowerExcess > -1 && Result->UpperExcess < 1
+						&& Result->Zeros == Count;
+	}
+
+// -------------------------------------------------------------------
+// Clean up.
+// -------------------------------------------------------------------
+for(i = 0; i < run.nSub; i++) {
+	mpfr_clears (run.subPts[i].t, run.subPts[i].Result, (mpfr_ptr) 0);
+	}
+for(i = 0; i < run.nGram; i++) {
+	mpfr_clears (run.gram[i].t, run.gram[i].Result, (mpfr_ptr) 0);
+	}
+free(run.subPts);
+free(run.gram);
+free(run.sub);
+free(Flags);
+mpfr_clears (nFirst, nRef, Accuracy, Temp1, (mpfr_ptr) 0);
+return(Result->Evaluations > 0 ? 1 : -1);
+}
+
+// -------------------------------------------------------------------
+// The pool task for one Z value.
+// -------------------------------------------------------------------
+static void TuringZTask(void *Arg)
+{
+HardyZSingleBall((struct computeHZ *) Arg);
+}
+
+// -------------------------------------------------------------------
+// The sign of Z at a computed point: 1 or -1 if it is certain, 0 if
+// the point's ball contains zero.
+// -------------------------------------------------------------------
+static int TuringSign(struct computeHZ *pt)
+{
+return(HardyZBallSign(pt->Result, pt->Radius));
+}
+
+// -------------------------------------------------------------------
+// Compute Z at Count points, on the worker pool.
+// -------------------------------------------------------------------
+static int TuringEvaluate(struct computeHZ *pts, uint64_t Count)
+{
+struct HGT_BATCH	*Batch;
+uint64_t			i;
+
+Batch = PoolBatchCreate();
+for(i = 0; i < Count; i++) {
+	PoolSubmit(Batch, TuringZTask, &pts[i]);
+	}
+PoolWaitBatch(Batch);
+PoolBatchFree(Batch);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Count the sign changes of Z in Gram interval i (from gram[i] to
+// gram[i+1], through the sub points if there are any), between points
+// whose signs are certain.  For each one, between points u < v, we 
+// add (Ref - v) to Sum if Mode is 1, or (u - Ref) if Mode is -1.
+// -------------------------------------------------------------------
+static uint64_t TuringChanges(struct turingRun *run, uint64_t i, mpfr_t Sum,
+	mpfr_t Ref, int Mode)
+{
+struct computeHZ	*Prev, *Next;
+uint64_t			Changes = 0;
+int					j, nSteps;
+
+nSteps = run->sub[i] != NULL ? run->SubIntvl : 1;
+Prev   = &run->gram[i];
+for(j = 0; j < nSteps; j++) {
+	Next = (j == nSteps - 1) ? &run->gram[i + 1] : &run->sub[i][j];
+	if(TuringSign(Next) == 0) {
+		continue;
+		}
+	if(TuringSign(Prev) * TuringSign(Next) < 0) {
+		Changes++;
+		if(Mode == 1) {
+			mpfr_add (Sum, Sum, Ref, MPFR_RNDD);
+			mpfr_sub (Sum, Sum, Next->t, MPFR_RNDD);
+			}
+		else if(Mode == -1) {
+			mpfr_add (Sum, Sum, Prev->t, MPFR_RNDD);
+			mpfr_sub (Sum, Sum, Ref, MPFR_RNDD);
+			}
+		}
+	Prev = Next;
+	}
+return(Changes);
+}
+
+// -------------------------------------------------------------------
+// Find the Gram blocks (between consecutive good Gram points) with
+// fewer sign changes than Gram intervals, and split each of their
+// Gram intervals into SubIntvl pieces.  We also split the GramPts Gram
+// intervals at each end, which pins down the zeros there and so
+// tightens Turing's bound, and the Gram intervals on either side of a
+// Gram point whose sign is not certain.  All of the new points are computed in one
+// batch.  We return the number of new points.
+// -------------------------------------------------------------------
+static int TuringSubdivide(struct turingRun *run, bool *Flags, int GramPts,
+	uint64_t *BadBlocks)
+{
+struct computeHZ	*pts;
+bool				*Split;
+uint64_t			i, j, k, Start, Changes, nSplit = 0;
+int					s;
+
+// -------------------------------------------------------------------
+// Pass 1: find the Gram intervals to split.
+// -------------------------------------------------------------------
+Split = calloc(run->nGram, sizeof(bool));
+for(i = 0; i < (uint64_t) GramPts; i++) {
+	Split[i] = Split[run->nGram - 2 - i] = true;
+	}
+for(i = 0; i < run->nGram; i++) {
+	if(TuringSign(&run->gram[i]) == 0) {
+		Split[i > 0 ? i - 1 : 0] = true;
+		Split[i + 1 < run->nGram ? i : run->nGram - 2] = true;
+		}
+	}
+for(Start = 0; Start < run->nGram && Flags[Start] == false; Start++);
+for(j = Start, k = Start + 1; k < run->nGram; k++) {
+	if(Flags[k] == false) {
+		continue;
+		}
+	for(i = j, Changes = 0; i < k; i++) {
+		Changes += TuringChanges(run, i, NULL, NULL, 0);
+		}
+	if(Changes < k - j) {
+		for(i = j; i < k; i++) {
+			Split[i] = true;
+			}
+		}
+	j = k;
+	}
+for(i = 0; i < run->nGram; i++) {
+	nSplit += Split[i] == true ? 1 : 0;
+	}
+
+// -------------------------------------------------------------------
+// Pass 2: set up the sub points, and compute Z at all of them.
+// -------------------------------------------------------------------
+run->nSub	= nSplit * (run->SubIntvl - 1);
+run->subPts = malloc((run->nSub > 0 ? run->nSub : 1) * sizeof(struct computeHZ));
+for(i = 0, pts = run->subPts; i < run->nGram; i++) {
+	if(Split[i] == false) {
+		continue;
+		}
+	run->sub[i] = pts;
+	for(s = 1; s < run->SubIntvl; s++, pts++) {
+		mpfr_inits2 (hgt_init.DefaultBits, pts->t, pts->Result, (mpfr_ptr) 0);
+		mpfr_sub (pts->t, run->gram[i + 1].t, run->gram[i].t, MPFR_RNDN);
+		mpfr_mul_ui (pts->t, pts->t, s, MPFR_RNDN);
+		mpfr_div_ui (pts->t, pts->t, run->SubIntvl, MPFR_RNDN);
+		mpfr_add (pts->t, pts->t, run->gram[i].t, MPFR_RNDN);
+		}
+	}
+free(Split);
+TuringEvaluate(run->subPts, run->nSub);
+
+// -------------------------------------------------------------------
+// Pass 3: count the blocks that still come up short.
+// -------------------------------------------------------------------
+for(j = Start, k = Start + 1; k < run->nGram; k++) {
+	if(Flags[k] == false) {
+		continue;
+		}
+	for(i = j, Changes = 0; i < k; i++) {
+		Changes += TuringChanges(run, i, NULL, NULL, 0);
+		}
+	if(Changes < k - j) {
+		(*BadBlocks)++;
+		}
+	j = k;
+	}
+return((int) run->nSub);
+}
+
+// -------------------------------------------------------------------
+// The integral of theta(t), using the same asymptotic formula as
+// ThetaOfT:
+//
+//		(t^2/4) log(t/(2 pi)) - 3t^2/8 - pi t/8 + log(t)/48
+//			- 7/(11520 t^2)
+//
+// rounded up (Rnd = MPFR_RNDU) or down (MPFR_RNDD).  For t > 168 pi
+// each part is positive, so each step is rounded in the direction 
+// that moves Result the way Rnd says, with pi rounded the other way.
+// -------------------------------------------------------------------
+static int ThetaIntegral(mpfr_t *Result, mpfr_t t, mpfr_rnd_t Rnd)
+{
+mpfr_t		Pi, Temp1, Temp2, Sum;
+mpfr_rnd_t	Opp = (Rnd == MPFR_RNDU) ? MPFR_RNDD : MPFR_RNDU;
+int			Bits = mpfr_get_prec (*Result);
+
+mpfr_inits2 (Bits, Pi, Temp1, Temp2, Sum, (mpfr_ptr) 0);
+mpfr_const_pi (Pi, Opp);
+
+mpfr_div (Temp1, t, Pi, Rnd);
+mpfr_div_2ui (Temp1, Temp1, 1, Rnd);
+mpfr_log (Temp1, Temp1, Rnd);
+mpfr_sub_d (Temp1, Temp1, 1.5, Rnd);
+mpfr_sqr (Temp2, t, Rnd);
+mpfr_mul (Sum, Temp1, Temp2, Rnd);
+mpfr_div_2ui (Sum, Sum, 2, Rnd);				// (t^2/4)(log(t/2pi) - 3/2)
+
+mpfr_mul (Temp1, Pi, t, Opp);
+mpfr_div_2ui (Temp1, Temp1, 3, Opp);
+mpfr_sub (Sum, Sum, Temp1, Rnd);
+
+mpfr_log (Temp1, t, Rnd);
+mpfr_div_ui (Temp1, Temp1, 48, Rnd);
+mpfr_add (Sum, Sum, Temp1, Rnd);
+
+mpfr_mul_ui (Temp1, Temp2, 11520, Rnd);
+mpfr_ui_div (Temp1, 7, Temp1, Opp);
+mpfr_sub (*Result, Sum, Temp1, Rnd);
+
+mpfr_clears (Pi, Temp1, Temp2, Sum, (mpfr_ptr) 0);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Turing's bound over Gram intervals First .. Last - 1.  With Side = 1
+// this is the upper bound on N(g_b) - b - 1, where g_b = gram[First];
+// with Side = -1, the lower bound on N(g_a) - a - 1, where g_a =
+// gram[Last].  nRef is b (or a).  The bound holds for the points 
+// gram[First].t and gram[Last].t as computed (they need not be the 
+// exact Gram points).  Each step is rounded up (Side = 1) or down 
+// (Side = -1), and theta(t) is allowed to differ from the formula
+// ThetaIntegral uses by 62/(80640 t^5), as in RS_MainTermBound.
+// -------------------------------------------------------------------
+static double TuringBound(struct turingRun *run, uint64_t First, uint64_t Last,
+	mpfr_t nRef, int Side)
+{
+mpfr_t		Len, SumL, IntTheta, Temp1, Bound, Pi;
+mpfr_ptr	tStart, tEnd;
+mpfr_rnd_t	Rnd = (Side == 1) ? MPFR_RNDU : MPFR_RNDD;
+mpfr_rnd_t	Opp = (Side == 1) ? MPFR_RNDD : MPFR_RNDU;
+uint64_t	i;
+double		Excess;
+
+tStart = run->gram[First].t;
+tEnd   = run->gram[Last].t;
+mpfr_inits2 (hgt_init.DefaultBits + 64, SumL, IntTheta, Temp1, Bound, Pi, (mpfr_ptr) 0);
+
+// -------------------------------------------------------------------
+// Len = tEnd - tStart, exactly (with the bits of tEnd, plus those 
+// between the leading bits of tEnd and tStart).
+// -------------------------------------------------------------------
+mpfr_init2 (Len, mpfr_get_prec (tEnd) + mpfr_get_prec (tStart)
+	+ (mpfr_get_exp (tEnd) - mpfr_get_exp (tStart)) + 1);
+mpfr_sub (Len, tEnd, tStart, MPFR_RNDN);
+
+// -------------------------------------------------------------------
+// Bound = B(t2) = 2.067 + 0.059 log t2, where t2 = tEnd.
+// -------------------------------------------------------------------
+mpfr_log (Bound, tEnd, MPFR_RNDU);
+mpfr_mul_d (Bound, Bound, HGT_TUR_B1, MPFR_RNDU);
+mpfr_add_d (Bound, Bound, HGT_TUR_B0, MPFR_RNDU);
+
+// -------------------------------------------------------------------
+// SumL is (a lower bound on) the integral of L, or L'.
+// -------------------------------------------------------------------
+mpfr_set_zero (SumL, 1);
+for(i = First; i < Last; i++) {
+	TuringChanges(run, i, SumL, (Side == 1) ? tEnd : tStart, Side);
+	}
+
+// -------------------------------------------------------------------
+// IntTheta is the integral of (theta/pi - nRef), with the truncation
+// of theta: Len * 62/(80640 tStart^5), added (Side = 1) or taken off.
+// -------------------------------------------------------------------
+ThetaIntegral(&IntTheta, tEnd, Rnd);
+ThetaIntegral(&Temp1, tStart, Opp);
+mpfr_sub (IntTheta, IntTheta, Temp1, Rnd);
+mpfr_pow_ui (Temp1, tStart, 5, MPFR_RNDD);
+mpfr_mul_ui (Temp1, Temp1, 80640, MPFR_RNDD);
+mpfr_ui_div (Temp1, 62, Temp1, MPFR_RNDU);
+mpfr_mul (Temp1, Temp1, Len, MPFR_RNDU);
+if(Side == 1) {
+	mpfr_add (IntTheta, IntTheta, Temp1, Rnd);
+	}
+else {
+	mpfr_sub (IntTheta, IntTheta, Temp1, Rnd);
+	}
+mpfr_const_pi (Pi, Opp);
+mpfr_div (IntTheta, IntTheta, Pi, Rnd);
+mpfr_mul (Temp1, nRef, Len, Opp);
+mpfr_sub (IntTheta, IntTheta, Temp1, Rnd);
+
+// -------------------------------------------------------------------
+// Side = 1:  (Bound - SumL + IntTheta) / Len
+// Side = -1: (-Bound + SumL + IntTheta) / Len
+// -------------------------------------------------------------------
+if(Side == 1) {
+	mpfr_sub (Temp1, Bound, SumL, MPFR_RNDU);
+	}
+else {
+	mpfr_sub (Temp1, SumL, Bound, MPFR_RNDD);
+	}
+mpfr_add (Temp1, Temp1, IntTheta, Rnd);
+mpfr_div (Temp1, Temp1, Len, Rnd);
+Excess = mpfr_get_d (Temp1, Rnd);
+
+mpfr_clears (Len, SumL, IntTheta, Temp1, Bound, Pi, (mpfr_ptr) 0);
+return(Excess);
+}
@@ -0,0 +1,287 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file finds the zeros of Z(t) to a requested tolerance.  We
+// start from a bracket [a, b] with Z(a) and Z(b) of opposite sign,
+// and each step computes Z(x) and Z'(x) together (HardyZSingleDeriv).
+// The bracket is then narrowed by the sign of Z(x), and the next x
+// is the Newton step x - Z(x)/Z'(x) if that lies inside the bracket,
+// or else the Illinois step (the secant through the bracket ends,
+// where the value kept at an end is halved each time that end is
+// kept twice in a row).  Near a simple zero, Newton converges
+// quadratically; the Illinois step makes sure we never leave the
+// bracket and that it keeps shrinking.  We stop when a Newton step
+// is at most Tol, or the bracket is at most Tol wide.
+// -------------------------------------------------------------------
+
+struct zeroItem {
+	mpfr_t				a, b, fa, fb;	// Z(a), Z(b) of opposite sign
+	mpfr_t				Root, Deriv;
+	mpfr_ptr			Tol;
+	struct HGT_BATCH	*Batch;
+	int					Evals;
+	int					Status;
+	int					Done;
+};
+
+static int	ZeroRefine(struct zeroItem *zi);
+static void	ZeroRefineTask(void *Arg);
+static void	ZeroSampleTask(void *Arg);
+
+// *******************************************************************
+// Find the zero of Z(t) in [a, b] to within Tol.  Z(a) and Z(b) must
+// differ in sign; if not, we return -1.  Otherwise we return 1 (or 0
+// if HGT_ZERO_ITER_MAX steps did not reach Tol, in which case *Root
+// is the best value we have).  If Evals is not NULL, we put the
+// number of evaluations of Z (including those at a and b) there.
+// *******************************************************************
+int HardyZRefineZero(mpfr_t *Root, mpfr_t a, mpfr_t b, mpfr_t Tol, int *Evals)
+{
+struct zeroItem		zi;
+struct computeHZ	comphz;
+
+mpfr_inits2 (hgt_init.DefaultBits, zi.a, zi.b, zi.fa, zi.fb, zi.Root, zi.Deriv,
+	comphz.t, comphz.Result, (mpfr_ptr) 0);
+zi.Tol = Tol;
+
+// -------------------------------------------------------------------
+// Z at the ends.  Z' there is not needed (ZeroRefine computes Z' at
+// each point it tries), so HardyZSingle will do.
+// -------------------------------------------------------------------
+mpfr_set (comphz.t, a, MPFR_RNDN);
+HardyZSingle(&comphz);
+mpfr_set (zi.a, a, MPFR_RNDN);
+mpfr_set (zi.fa, comphz.Result, MPFR_RNDN);
+mpfr_set (comphz.t, b, MPFR_RNDN);
+HardyZSingle(&comphz);
+mpfr_set (zi.b, b, MPFR_RNDN);
+mpfr_set (zi.fb, comphz.Result, MPFR_RNDN);
+
+if(mpfr_sgn (zi.fa) * mpfr_sgn (zi.fb) < 0) {
+	ZeroRefine(&zi);
+	mpfr_set (*Root, zi.Root, MPFR_RNDN);
+	}
+else {
+	zi.Status = -1;
+	zi.Evals  = 0;
+	}
+if(Evals != NULL) {
+	*Evals = zi.Evals + 2;
+	}
+
+mpfr_clears (zi.a, zi.b, zi.fa, zi.fb, zi.Root, zi.Deriv, comphz.t, comphz.Result,
+	(mpfr_ptr) 0);
+return(zi.Status);
+}
+
+// *******************************************************************
+// Find the zeros of Z(t) in [a, b].  We compute Z at Samples + 1
+// evenly spaced points, and refine each sign change to within Tol.
+// Both steps run on the worker pool.  Each zero is passed to
+// pCallbackHZ in order, with Z' there (useful to see that the zero
+// is simple) as the second argument.  A zero is missed if Z has two
+// of them (or none, but touches zero) between neighboring samples,
+// so the spacing should be well under the gap between zeros, about
+// 2 pi / log(t / 2 pi).  We return the number of zeros found.
+// *******************************************************************
+int HardyZFindZeros(mpfr_t a, mpfr_t b, int Samples, mpfr_t Tol, int CallerID,
+	pHardyZCallback pCallbackHZ)
+{
+struct computeHZ	*pts;
+struct zeroItem		*items;
+struct HGT_BATCH	*Batch;
+mpfr_t				Incr;
+int					i, nZeros = 0;
+
+if(Samples < 1) {
+	return(0);
+	}
+
+// -------------------------------------------------------------------
+// Step 1.  Z at the sample points.
+// -------------------------------------------------------------------
+mpfr_init2 (Incr, hgt_init.DefaultBits);
+mpfr_sub (Incr, b, a, MPFR_RNDN);
+mpfr_div_si (Incr, Incr, Samples, MPFR_RNDN);
+pts	  = malloc((Samples + 1) * sizeof(struct computeHZ));
+Batch = PoolBatchCreate();
+for(i = 0; i <= Samples; i++) {
+	mpfr_inits2 (hgt_init.DefaultBits, pts[i].t, pts[i].Result, (mpfr_ptr) 0);
+	mpfr_mul_si (pts[i].t, Incr, i, MPFR_RNDN);
+	mpfr_add (pts[i].t, pts[i].t, a, MPFR_RNDN);
+	PoolSubmit(Batch, ZeroSampleTask, &pts[i]);
+	}
+PoolWaitBatch(Batch);
+PoolBatchFree(Batch);
+
+// -------------------------------------------------------------------
+// Step 2.  Refine each sign change (one pool task each), and pass on
+// the zeros in order as they are done.
+// -------------------------------------------------------------------
+items = malloc(Samples * sizeof(struct zeroItem));
+Batch = PoolBatchCreate();
+for(i = 0; i < Samples; i++) {
+	if(mpfr_sgn (pts[i].Result) * mpfr_sgn (pts[i + 1].Result) >= 0) {
+		continue;
+		}
+	mpfr_inits2 (hgt_init.DefaultBits, items[nZeros].a, items[nZeros].b,
+		items[nZeros].fa, items[nZeros].fb, items[nZeros].Root, items[nZeros].Deriv,
+		(mpfr_ptr) 0);
+	mpfr_set (items[nZeros].a,  pts[i].t, MPFR_RNDN);
+	mpfr_set (items[nZeros].fa, pts[i].Result, MPFR_RNDN);
+	mpfr_set (items[nZeros].b,  pts[i + 1].t, MPFR_RNDN);
+	mpfr_set (items[nZeros].fb, pts[i + 1].Result, MPFR_RNDN);
+	items[nZeros].Tol	= Tol;
+	items[nZeros].Batch	= Batch;
+	items[nZeros].Done	= 0;
+	PoolSubmit(Batch, ZeroRefineTask, &items[nZeros]);
+	nZeros++;
+	}
+for(i = 0; i < nZeros; i++) {
+	PoolWaitItem(Batch, &items[i].Done);
+	pCallbackHZ(items[i].Root, items[i].Deriv, i, CallerID);
+	}
+PoolWaitBatch(Batch);
+PoolBatchFree(Batch);
+
+// -------------------------------------------------------------------
+// Clean up.
+// -------------------------------------------------------------------
+for(i = 0; i < nZeros; i++) {
+	mpfr_clears (items[i].a, items[i].b, items[i].fa, items[i].fb, items[i].Root,
+		items[i].Deriv, (mpfr_ptr) 0);
+	}
+for(i = 0; i <= Samples; i++) {
+	mpfr_clears (pts[i].t, pts[i].Result, (mpfr_ptr) 0);
+	}
+free(items);
+free(pts);
+mpfr_clear (Incr);
+return(nZeros);
+}
+
+// -------------------------------------------------------------------
+// The pool tasks: Z at one sample point, and one zero.
+// -------------------------------------------------------------------
+static void ZeroSampleTask(void *Arg)
+{
+HardyZSingle((struct computeHZ *) Arg);
+}
+
+static void ZeroRefineTask(void *Arg)
+{
+struct zeroItem		*zi = (struct zeroItem *) Arg;
+
+ZeroRefine(zi);
+PoolItemDone(zi->Batch, &zi->Done);
+}
+
+// -------------------------------------------------------------------
+// Refine the bracket in *zi (which this changes) to a zero in
+// zi->Root, with Z' at the last point we tried in zi->Deriv.  We set
+// zi->Evals, and zi->Status to 1 (done) or 0 (out of steps).
+// -------------------------------------------------------------------
+static int ZeroRefine(struct zeroItem *zi)
+{
+struct computeHZ	comphz;
+mpfr_t				Step, Temp1;
+int					iCmpA, iCmpB;
+int					Side = 0;	// end moved last time: -1 for b, 1 for a
+bool				bNewton;
+
+mpfr_inits2 (hgt_init.DefaultBits, comphz.t, comphz.Result, Step, Temp1, (mpfr_ptr) 0);
+zi->Evals  = 0;
+zi->Status = 0;
+
+// -------------------------------------------------------------------
+// Start from the secant step.  The bracket [a, b] always has
+// Z(a) Z(b) < 0 (although fa or fb may have been halved).
+// -------------------------------------------------------------------
+mpfr_sub (Temp1, zi->fb, zi->fa, MPFR_RNDN);
+mpfr_sub (Step, zi->b, zi->a, MPFR_RNDN);
+mpfr_mul (Step, Step, zi->fa, MPFR_RNDN);
+mpfr_div (Step, Step, Temp1, MPFR_RNDN);
+mpfr_sub (comphz.t, zi->a, Step, MPFR_RNDN);
+mpfr_set_ui (zi->Deriv, 0, MPFR_RNDN);
+
+while(zi->Evals < HGT_ZERO_ITER_MAX) {
+	HardyZSingleDeriv(&comphz, zi->Deriv);
+	zi->Evals++;
+	if(mpfr_zero_p (comphz.Result)) {
+		zi->Status = 1;
+		break;
+		}
+
+	// ---------------------------------------------------------------
+	// Narrow the bracket, halving the far end's value if the same
+	// end was moved twice in a row.
+	// ---------------------------------------------------------------
+	if(mpfr_sgn (comphz.Result) == mpfr_sgn (zi->fa)) {
+		mpfr_set (zi->a, comphz.t, MPFR_RNDN);
+		mpfr_set (zi->fa, comphz.Result, MPFR_RNDN);
+		if(Side == 1) {
+			mpfr_div_2ui (zi->fb, zi->fb, 1, MPFR_RNDN);
+			}
+		Side = 1;
+		}
+	else {
+		mpfr_set (zi->b, comphz.t, MPFR_RNDN);
+		mpfr_set (zi->fb, comphz.Result, MPFR_RNDN);
+		if(Side == -1) {
+			mpfr_div_2ui (zi->fa, zi->fa, 1, MPFR_RNDN);
+			}
+		Side = -1;
+		}
+
+	// ---------------------------------------------------------------
+	// Take the Newton step if it stays inside the bracket, and stop
+	// if it was at most Tol.  Otherwise take the Illinois step.
+	// ---------------------------------------------------------------
+	bNewton = false;
+	if(mpfr_zero_p (zi->Deriv) == 0) {
+		mpfr_div (Step, comphz.Result, zi->Deriv, MPFR_RNDN);
+		mpfr_sub (Temp1, comphz.t, Step, MPFR_RNDN);
+		iCmpA = mpfr_cmp (Temp1, zi->a);
+		iCmpB = mpfr_cmp (Temp1, zi->b);
+		bNewton = (iCmpA > 0 && iCmpB < 0) || (iCmpA < 0 && iCmpB > 0);
+		}
+	if(bNewton == true) {
+		mpfr_swap (comphz.t, Temp1);
+		if(mpfr_cmpabs (Step, zi->Tol) <= 0) {
+			zi->Status = 1;
+			break;
+			}
+		}
+	else {
+		mpfr_sub (Temp1, zi->fb, zi->fa, MPFR_RNDN);
+		mpfr_sub (Step, zi->b, zi->a, MPFR_RNDN);
+		mpfr_mul (Step, Step, zi->fa, MPFR_RNDN);
+		mpfr_div (Step, Step, Temp1, MPFR_RNDN);
+		mpfr_sub (comphz.t, zi->a, Step, MPFR_RNDN);
+		}
+
+	mpfr_sub (Temp1, zi->b, zi->a, MPFR_RNDN);
+	if(mpfr_cmpabs (Temp1, zi->Tol) <= 0) {
+		zi->Status = 1;
+		break;
+		}
+	}
+
+mpfr_set (zi->Root, comphz.t, MPFR_RNDN);
+mpfr_clears (comphz.t, comphz.Result, Step, Temp1, (mpfr_ptr) 0);
+return(zi->Status);
+}
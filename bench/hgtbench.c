@@ -0,0 +1,321 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <mpfr.h>
+
+#include "../hgt.h"
+
+// -------------------------------------------------------------------
+// The benchmark suite (built with "make bench").  For each precision
+// and each decade of t, we time the library's hot paths:
+//
+//		ThetaOfT, RS_MainTerm, RS_Remainder, HardyZSingle, GramAtN,
+//		GramNearT, and HardyZWithCount at 1, 2, 4, ... threads
+//
+// Each is run again and again for at least the given time (and at
+// least once).  The results are written as JSON, one record per
+// (function, t, bits, threads), with the time per call, the time per
+// term of the main sum where there is one, points per second, and
+// for HardyZWithCount the speedup and scaling efficiency (speedup
+// divided by threads) over one thread.  Progress goes to stderr.
+//
+// Usage: hgtbench [options]
+//		-q				quick run: t = 1e2..1e8, 64..256 bits
+//		-t <n>			largest t is 10^n (default 16)
+//		-b <b,b,...>	precisions (default 64,128,256,512,1024)
+//		-j <n>			most threads (default: the number of CPUs)
+//		-a <mode>		pin workers: none (default), core or node
+//		-s <seconds>	least time per measurement (default 0.2)
+//		-l <label>		label for the run, such as a commit id
+//		-o <file>		write the JSON to a file (default stdout)
+//
+// The full run (t up to 1e16 at 1024 bits, where the main sum has
+// 4 * 10^7 terms) takes a long time; use -t and -b to cut it down.
+// -------------------------------------------------------------------
+
+#define		BENCH_BITS_MAX		16
+#define		BENCH_POINTS_MAX	100000
+
+struct benchCase {
+	char				strT[8];		// "1e2" and so on
+	int					Bits;
+	mpfr_t				t, Incr, tOver2Pi, P, GramN, Accuracy, Result;
+	struct computeHZ	hz;
+	uint64_t			N;				// terms in the main sum
+	bool				nEven;
+	int					Count;			// points for HardyZWithCount
+};
+
+struct benchOut {
+	FILE				*File;
+	bool				First;			// no record written yet
+};
+
+typedef void	(*pBenchFunc)(struct benchCase *);
+
+static double	Seconds(void);
+static double	TimeIt(pBenchFunc Func, struct benchCase *bc, double MinSeconds,
+					long *Calls);
+static void		Record(struct benchOut *out, const char *Bench, struct benchCase *bc,
+					int Threads, long Calls, double Elapsed, uint64_t Terms);
+static void		RecordPoints(struct benchOut *out, struct benchCase *bc, int Threads,
+					double Elapsed, double Base);
+static int		CountCallback(mpfr_t t, mpfr_t Z, int Index, int CallerID);
+
+static void RunTheta(struct benchCase *bc)		{ ThetaOfT(&bc->Result, bc->t); }
+static void RunMain(struct benchCase *bc)		{ RS_MainTerm(&bc->Result, bc->t, bc->N, bc->Bits); }
+static void RunRemainder(struct benchCase *bc)	{ RS_Remainder(&bc->Result, bc->tOver2Pi, bc->nEven, bc->P, bc->Bits); }
+static void RunSingle(struct benchCase *bc)		{ HardyZSingle(&bc->hz); }
+static void RunGramAtN(struct benchCase *bc)	{ GramAtN(&bc->Result, bc->GramN, bc->Accuracy); }
+static void RunGramNearT(struct benchCase *bc)	{ GramNearT(&bc->Result, bc->t); }
+static void RunCount(struct benchCase *bc)		{ HardyZWithCount(bc->t, bc->Incr, bc->Count, 0, CountCallback); }
+
+int main(int argc, char **argv)
+{
+struct HGT_CONTEXT	*Contexts[32];
+struct benchCase	bc;
+struct benchOut		out = { stdout, true };
+const char			*SimdNames[] = { "scalar", "avx2", "avx512" };
+const char			*AffinityNames[] = { "none", "core", "node" };
+const char			*Label = "";
+char				strBits[128] = "64,128,256,512,1024", *Tok;
+int					Bits[BENCH_BITS_MAX], Threads[32];
+int					nBits = 0, nThreads = 0, MaxDecade = 16, MaxThreads, i, b, d, k;
+int					Affinity = HGT_AFFINITY_NONE;
+double				MinSeconds = 0.2, Elapsed, Single, Base = 0.0;
+long				Calls;
+time_t				Now = time(NULL);
+char				strDate[32];
+
+MaxThreads = HardwareThreads();
+for(i = 1; i < argc; i++) {
+	if(strcmp(argv[i], "-q") == 0) {
+		MaxDecade = 8;
+		strcpy(strBits, "64,128,256");
+		}
+	else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+		MaxDecade = atoi(argv[++i]);
+		}
+	else if(strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+		snprintf(strBits, sizeof(strBits), "%s", argv[++i]);
+		}
+	else if(strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+		MaxThreads = atoi(argv[++i]);
+		}
+	else if(strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
+		i++;
+		for(Affinity = HGT_AFFINITY_NODE; Affinity > HGT_AFFINITY_NONE 
+			&& strcmp(argv[i], AffinityNames[Affinity]) != 0; Affinity--)
+			;
+		}
+	else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+		MinSeconds = atof(argv[++i]);
+		}
+	else if(strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+		Label = argv[++i];
+		}
+	else if(strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+		if((out.File = fopen(argv[++i], "w")) == NULL) {
+			fprintf(stderr, "Cannot write %s\n", argv[i]);
+			return(1);
+			}
+		}
+	else {
+		fprintf(stderr, "Usage: hgtbench [-q] [-t n] [-b bits,...] [-j threads] "
+			"[-a none|core|node] [-s seconds] [-l label] [-o file]\n");
+		return(1);
+		}
+	}
+for(Tok = strtok(strBits, ","); Tok != NULL && nBits < BENCH_BITS_MAX; Tok = strtok(NULL, ",")) {
+	if(atoi(Tok) >= MPFR_PREC_MIN) {
+		Bits[nBits++] = atoi(Tok);
+		}
+	}
+MaxDecade  = MaxDecade < 2 ? 2 : (MaxDecade > 19 ? 19 : MaxDecade);
+MaxThreads = MaxThreads < 1 ? 1 : (MaxThreads > HGT_THREADS_MAX ? HGT_THREADS_MAX : MaxThreads);
+for(k = 1; k < MaxThreads && nThreads < 31; k *= 2) {
+	Threads[nThreads++] = k;
+	}
+Threads[nThreads++] = MaxThreads;
+
+// -------------------------------------------------------------------
+// The default context is used only for SimdLevel; each precision and
+// thread count gets a context of its own.
+// -------------------------------------------------------------------
+InitMPFR(64, 1, 1, true);
+SetThreadAffinity(Affinity);
+strftime(strDate, sizeof(strDate), "%Y-%m-%dT%H:%M:%SZ", gmtime(&Now));
+fprintf(out.File, "{\n \"suite\": \"hgtbench\",\n \"version\": 1,\n"
+	" \"label\": \"%s\",\n \"date\": \"%s\",\n \"cpus\": %d,\n"
+	" \"affinity\": \"%s\",\n \"simd\": \"%s\",\n \"min_seconds\": %g,\n"
+	" \"results\": [", Label, strDate, HardwareThreads(), AffinityNames[Affinity],
+	SimdNames[SimdLevel()], MinSeconds);
+
+for(b = 0; b < nBits; b++) {
+	for(k = 0; k < nThreads; k++) {
+		Contexts[k] = HgtContextCreate(Bits[b], Threads[k], 1, true);
+		}
+	HgtContextUse(Contexts[0]);
+	bc.Bits = Bits[b];
+	mpfr_inits2 (bc.Bits, bc.t, bc.Incr, bc.tOver2Pi, bc.P, bc.GramN, bc.Accuracy,
+		bc.Result, bc.hz.t, bc.hz.Result, (mpfr_ptr) 0);
+	mpfr_set_d (bc.Incr, 0.1, MPFR_RNDN);
+	mpfr_set_ui_2exp (bc.Accuracy, 1, -(bc.Bits / 2), MPFR_RNDN);
+
+	for(d = 2; d <= MaxDecade; d++) {
+		snprintf(bc.strT, sizeof(bc.strT), "1e%d", d);
+		fprintf(stderr, "bits %d, t = %s\n", bc.Bits, bc.strT);
+		mpfr_set_str (bc.t, bc.strT, 10, MPFR_RNDN);
+		mpfr_set (bc.hz.t, bc.t, MPFR_RNDN);
+
+		// -----------------------------------------------------------
+		// N, P and the parity of N, as HardyZSingle finds them, and
+		// the Gram index near t.
+		// -----------------------------------------------------------
+		mpfr_const_pi (bc.Result, MPFR_RNDN);
+		mpfr_mul_2ui (bc.Result, bc.Result, 1, MPFR_RNDN);
+		mpfr_div (bc.tOver2Pi, bc.t, bc.Result, MPFR_RNDN);
+		mpfr_sqrt (bc.Result, bc.tOver2Pi, MPFR_RNDN);
+		mpfr_modf (bc.GramN, bc.P, bc.Result, MPFR_RNDN);
+		bc.N	 = mpfr_get_uj (bc.GramN, MPFR_RNDN);
+		bc.nEven = bc.N % 2 == 0;
+		GramNearT(&bc.GramN, bc.t);
+
+		Elapsed = TimeIt(RunTheta, &bc, MinSeconds, &Calls);
+		Record(&out, "ThetaOfT", &bc, 1, Calls, Elapsed, 0);
+		Elapsed = TimeIt(RunMain, &bc, MinSeconds, &Calls);
+		Record(&out, "RS_MainTerm", &bc, 1, Calls, Elapsed, bc.N);
+		Elapsed = TimeIt(RunRemainder, &bc, MinSeconds, &Calls);
+		Record(&out, "RS_Remainder", &bc, 1, Calls, Elapsed, 0);
+		Elapsed = TimeIt(RunSingle, &bc, MinSeconds, &Calls);
+		Record(&out, "HardyZSingle", &bc, 1, Calls, Elapsed, bc.N);
+		Single = Elapsed / (double) Calls;
+		Elapsed = TimeIt(RunGramAtN, &bc, MinSeconds, &Calls);
+		Record(&out, "GramAtN", &bc, 1, Calls, Elapsed, 0);
+		Elapsed = TimeIt(RunGramNearT, &bc, MinSeconds, &Calls);
+		Record(&out, "GramNearT", &bc, 1, Calls, Elapsed, 0);
+
+		// -----------------------------------------------------------
+		// HardyZWithCount, with the same points (enough for about
+		// MinSeconds on one thread, and a few per thread) for every
+		// thread count.
+		// -----------------------------------------------------------
+		bc.Count = (int) ceil(MinSeconds / Single);
+		bc.Count = bc.Count < 4 * MaxThreads ? 4 * MaxThreads : bc.Count;
+		bc.Count = bc.Count > BENCH_POINTS_MAX ? BENCH_POINTS_MAX : bc.Count;
+		for(k = 0; k < nThreads; k++) {
+			HgtContextUse(Contexts[k]);
+			Elapsed = Seconds();
+			RunCount(&bc);
+			Elapsed = Seconds() - Elapsed;
+			Base = k == 0 ? Elapsed : Base;
+			RecordPoints(&out, &bc, Threads[k], Elapsed, Base);
+			}
+		HgtContextUse(Contexts[0]);
+		}
+
+	mpfr_clears (bc.t, bc.Incr, bc.tOver2Pi, bc.P, bc.GramN, bc.Accuracy,
+		bc.Result, bc.hz.t, bc.hz.Result, (mpfr_ptr) 0);
+	HgtContextUse(NULL);
+	for(k = 0; k < nThreads; k++) {
+		HgtContextFree(Contexts[k]);
+		}
+	}
+
+fprintf(out.File, "\n ]\n}\n");
+if(out.File != stdout) {
+	fclose(out.File);
+	}
+CloseMPFR();
+return(0);
+}
+
+// -------------------------------------------------------------------
+// Wall clock time, in seconds.
+// -------------------------------------------------------------------
+static double Seconds(void)
+{
+struct timespec	ts;
+
+timespec_get(&ts, TIME_UTC);
+return((double) ts.tv_sec + 1e-9 * (double) ts.tv_nsec);
+}
+
+// -------------------------------------------------------------------
+// Call Func until at least MinSeconds have gone by.  Returns the time
+// taken, and the number of calls in Calls.
+// -------------------------------------------------------------------
+static double TimeIt(pBenchFunc Func, struct benchCase *bc, double MinSeconds,
+	long *Calls)
+{
+double	Start = Seconds(), Elapsed;
+
+*Calls = 0;
+do {
+	Func(bc);
+	(*Calls)++;
+	Elapsed = Seconds() - Start;
+	} while(Elapsed < MinSeconds);
+return(Elapsed);
+}
+
+// -------------------------------------------------------------------
+// Write one JSON record.  Terms is the number of main sum terms per
+// call (0 if there is no main sum).
+// -------------------------------------------------------------------
+static void Record(struct benchOut *out, const char *Bench, struct benchCase *bc,
+	int Threads, long Calls, double Elapsed, uint64_t Terms)
+{
+double	nsCall = 1e9 * Elapsed / (double) Calls;
+
+fprintf(out->File, "%s\n  {\"bench\": \"%s\", \"t\": \"%s\", \"bits\": %d, "
+	"\"threads\": %d, \"calls\": %ld, \"seconds\": %.6f, \"ns_per_call\": %.1f, "
+	"\"points_per_sec\": %.3f", out->First ? "" : ",", Bench, bc->strT, bc->Bits,
+	Threads, Calls, Elapsed, nsCall, 1e9 / nsCall);
+if(Terms > 0) {
+	fprintf(out->File, ", \"terms\": %llu, \"ns_per_term\": %.3f",
+		(unsigned long long) Terms, nsCall / (double) Terms);
+	}
+fprintf(out->File, "}");
+fflush(out->File);
+out->First = false;
+}
+
+// -------------------------------------------------------------------
+// Write the record for a HardyZWithCount run of bc->Count points on
+// Threads threads, which took Elapsed seconds (Base on one thread).
+// -------------------------------------------------------------------
+static void RecordPoints(struct benchOut *out, struct benchCase *bc, int Threads,
+	double Elapsed, double Base)
+{
+double	Speedup = Base / Elapsed;
+
+fprintf(out->File, "%s\n  {\"bench\": \"HardyZWithCount\", \"t\": \"%s\", "
+	"\"bits\": %d, \"threads\": %d, \"points\": %d, \"seconds\": %.6f, "
+	"\"points_per_sec\": %.3f, \"ns_per_term\": %.3f, \"speedup\": %.3f, "
+	"\"efficiency\": %.3f}", out->First ? "" : ",", bc->strT, bc->Bits, Threads,
+	bc->Count, Elapsed, (double) bc->Count / Elapsed,
+	1e9 * Elapsed / ((double) bc->Count * (double) (bc->N > 0 ? bc->N : 1)),
+	Speedup, Speedup / (double) Threads);
+fflush(out->File);
+out->First = false;
+}
+
+static int CountCallback(mpfr_t t, mpfr_t Z, int Index, int CallerID)
+{
+(void) t;
+(void) Z;
+(void) Index;
+(void) CallerID;
+return(1);
+}
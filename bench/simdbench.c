@@ -0,0 +1,83 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <mpfr.h>
+
+#include "../hgt.h"
+
+// -------------------------------------------------------------------
+// Throughput of the double backend main-sum kernel (hgtSimd.c) for
+// each SIMD level the CPU supports, at t = 10^8, 10^10 and 10^12.
+// For each t we report terms per second, the speedup over the scalar
+// kernel and the difference from the MPFR main term (RS_MainTerm).
+//
+// Usage: simdbench [bits]		(MPFR precision, default 128)
+// -------------------------------------------------------------------
+static double Seconds(void)
+{
+struct timespec	ts;
+
+timespec_get(&ts, TIME_UTC);
+return((double) ts.tv_sec + 1e-9 * (double) ts.tv_nsec);
+}
+
+int main(int argc, char **argv)
+{
+const char	*Names[] = { "scalar", "avx2", "avx512" };
+const char	*strT[] = { "1e8", "1e10", "1e12" };
+mpfr_t		t, Theta, N, Main, Diff;
+double		tParts[3], ThetaParts[3], Sum[2], Start, Elapsed, Scalar = 0.0;
+uint64_t	ui64N;
+int			Bits, Best, Level, i, Reps;
+
+Bits = argc > 1 ? atoi(argv[1]) : 128;
+InitMPFR(Bits, 1, 1, true);
+Best = SetSimdLevel(HGT_SIMD_AVX512);
+mpfr_inits2 (Bits, t, Theta, N, Main, Diff, (mpfr_ptr) 0);
+
+printf("%-6s %8s %-7s %12s %8s %10s\n", "t", "N", "kernel", "Mterms/s",
+	"speedup", "vs MPFR");
+for(i = 0; i < 3; i++) {
+	mpfr_set_str (t, strT[i], 10, MPFR_RNDN);
+	mpfr_div (N, t, hgt_init.my2Pi, MPFR_RNDN);
+	mpfr_sqrt (N, N, MPFR_RNDN);
+	ui64N = mpfr_get_uj (N, MPFR_RNDZ);
+	ThetaOfT(&Theta, t);
+	MPFRToTripleDouble(tParts, t);
+	MPFRToTripleDouble(ThetaParts, Theta);
+	RS_MainTerm(&Main, t, ui64N, Bits);
+
+	for(Level = HGT_SIMD_SCALAR; Level <= Best; Level++) {
+		SetSimdLevel(Level);
+		Reps = 0;
+		Start = Seconds();
+		do {
+			MainSumDouble(Sum, tParts, ThetaParts, 1, ui64N);
+			Reps++;
+			Elapsed = Seconds() - Start;
+			} while(Elapsed < 0.5);
+		Elapsed = (double) Reps * (double) ui64N / Elapsed / 1e6;
+		if(Level == HGT_SIMD_SCALAR) {
+			Scalar = Elapsed;
+			}
+		mpfr_sub_d (Diff, Main, 2.0 * Sum[0], MPFR_RNDN);
+		mpfr_sub_d (Diff, Diff, 2.0 * Sum[1], MPFR_RNDN);
+		printf("%-6s %8llu %-7s %12.2f %7.2fx %10.2e\n", strT[i],
+			(unsigned long long) ui64N, Names[Level], Elapsed, Elapsed / Scalar,
+			mpfr_get_d (Diff, MPFR_RNDN));
+		}
+	}
+mpfr_clears (t, Theta, N, Main, Diff, (mpfr_ptr) 0);
+CloseMPFR();
+return(0);
+}
@@ -1,6 +1,6 @@
 
 // -------------------------------------------------------------------
-// File last modified January 9, 2026. 
+// File last modified October 16, 2026. 
 // Copyright (c) 2025-2026 Terrence P. Murphy
 // MIT License -- see below for details.
 // -------------------------------------------------------------------
@@ -36,26 +36,56 @@ struct HGT_INIT {
 	int			DefaultBits;
 	int			MaxThreads;
 	int			DebugFlags;
+	int			AccuracyDigits;		// 0 = always use MPFR
+	int			Instrument;			// HGT_INSTRUMENT_ flags (hgtStats.c)
+	bool		FixedPoint;			// main sum in fixed point (hgtFixed.c)
 }; 
 
+struct HGT_POOL;			// opaque; see hgtPool.c
+
 typedef int	(*pHardyZCallback)(mpfr_t, mpfr_t, int, int);
+typedef int	(*pHardyZRangeCallback)(mpfr_t, mpfr_t, uint64_t, int);
+typedef int	(*pHardyZBallCallback)(mpfr_t, mpfr_t, double, uint64_t, int);
+typedef void (*pPoolTask)(void *);
+
+struct HGT_BATCH;			// opaque; see hgtPool.c
+struct HGT_RING;			// opaque; see hgtRing.c
+struct HGT_JOB;				// opaque; see hgtJob.c
+struct HGT_JOBS;
+struct HGT_QUEUE;
+
+struct HGT_WORKMARK {				// see hgtWork.c
+	void		*Block;
+	size_t		Used;
+};
 
 struct computeHZ {
 	mpfr_t		t; 					// 't' value to compute
 	mpfr_t		Result; 			// To hold mpfr computed value
+	double		Radius;				// |Result - Z(t)| <= Radius (HardyZSingle)
 }; 
 
+struct HGT_TURING {					// see TuringCalc.c
+	uint64_t	Zeros;				// sign changes of Z from g_N to g_{N+Count}
+	uint64_t	Evaluations;		// Z values computed
+	uint64_t	BadBlocks;			// Gram blocks that fail Rosser's rule
+	double		LowerExcess;		// N(g_N) - N - 1 >= LowerExcess
+	double		UpperExcess;		// N(g_{N+Count}) - (N+Count) - 1 <= UpperExcess
+	bool		Verified;			// all Count zeros found, and no others
+};
+
 
 #define		HGT_PRECISION_DEFAULT	256
 #define		HGT_PRECISION_MIN		64
 #define		HGT_PRECISION_MAX		1024
 
-#define		HGT_THREADS_MIN			1
-#define		HGT_THREADS_MAX			8
+#define		HGT_THREADS_MIN			0		// 0 = one per CPU (HardwareThreads)
+#define		HGT_THREADS_MAX			1024
+#define		HGT_NUMA_NODES_MAX		64
 #define		HGT_MAX_CMDLINE_STRLEN	98
 
 #define		HGT_DEBUG_MIN			2
-#define		HGT_DEBUG_MAX			30030		// for up to 23 = 223,092,870
+#define		HGT_DEBUG_MAX			9699690		// for up to 23 = 223,092,870
 												// for up to 19 = 9,699,690
 #define		HGT_HARDY_T_MIN			1	
 #define		HGT_HARDY_T_MAX			1.15e20		// (otherwise N > 8-byte uint64_t)
@@ -64,7 +94,7 @@ struct computeHZ {
 #define		HGT_T_INCR_MAX			1.15e10
 
 #define		HGT_COUNT_MIN			1	
-#define		HGT_COUNT_MAX			9999
+#define		HGT_COUNT_MAX			1e18		// see HardyZWithRange
 
 #define		HGT_GRAM_T_MIN			100	
 #define		HGT_GRAM_T_MAX			2e30	
@@ -73,6 +103,9 @@ struct computeHZ {
 #define		HGT_GRAM_N_MAX			2e32
 
 #define		HGT_GRAM_LOOP_MAX		1000									
+#define		HGT_GRAM_NEWTON_MAX		32		// Newton steps before bisection
+#define		HGT_GRAM_CHUNK			4096	// Gram points per GramRange task
+#define		HGT_GRAM_SKIP_BITS		16		// GramRange safety margin
 
 #define		HGT_GRAM_ACCURACY_MIN	1
 #define		HGT_GRAM_ACCURACY_MAX	32								
@@ -86,6 +119,10 @@ struct computeHZ {
 #define		HGT_TUR_SUBINTVL_MIN	8
 #define		HGT_TUR_SUBINTVL_MAX	128
 
+#define		HGT_TUR_B0				2.067	// Trudgian's bound on the integral
+#define		HGT_TUR_B1				0.059	// of S(t): B0 + B1 log t2
+#define		HGT_TUR_T_MIN_PI		168		// ... valid for t > 168 pi
+
 #define		HGT_RPT_DEC_PLACES_MIN	2	
 #define		HGT_RPT_DEC_PLACES_MAX	60
 
@@ -93,13 +130,93 @@ struct computeHZ {
 #define		GABCKE_NUM_Cj_TERMS		5
 #define		GABCKE_DECIMAL_PLACES	50
 #define		GABCKE_NUM_POWERS_P		88
+#define		GABCKE_REMAINDER_TOL	1e-53	// see RS_Remainder
+#define		GABCKE_TABLE_ERROR		1e-45	// per Cj; see RS_RemainderBound
+#define		HGT_RS_BOUND_D4			0.017	// Gabcke: |R_4(t)| <= d_4 t^{-11/4}
+#define		HGT_RS_BOUND_T_MIN		200		// ... for t >= 200
 
 #define		THETA_MAX_T_POWER3		1.1e12
 
+#define		HGT_POOL_DEQUE_INIT		64		// initial task slots per queue
+#define		HGT_WORK_BLOCK			65536	// bytes per workspace block
+#define		HGT_RING_SIZE			1024	// results in flight in HardyZWithRange
+#define		HGT_STREAM_CHUNK		16		// points per HardyZWithRange task
+#define		HGT_FILE_DOUBLE			0		// result file formats (hgtFile.c)
+#define		HGT_FILE_MPFR			1
+#define		HGT_FILE_FIXED			128		// bytes for struct HGT_FILE_HEADER
+#define		HGT_FILE_CHECKPOINT		4096	// records per commit
+#define		HGT_FILE_INDEX_STRIDE	1024	// records per index entry
+
+#define		HGT_RING_SPIN			64		// polls before the consumer sleeps
+
+#define		HGT_GRID_GUARD_BITS		32		// extra bits for the grid engine
+#define		HGT_GRID_OVERSAMPLE		2		// coarse grid oversampling factor
+#define		HGT_GRID_FFT_MAX		4096	// largest FFT (power of 2)
+#define		HGT_GRID_MIN_N			64		// smallest N for the grid engine
+#define		HGT_GRID_COST_TERM		30.0	// multiplies per RS_MainTerm term
+#define		HGT_GRID_WINDOW			4096	// most points per window
+
+#define		HGT_MAIN_SPLIT_MIN		32768	// N at which RS_MainTerm splits
+#define		HGT_MAIN_BLOCK			4096	// terms per RS_MainTerm block
+#define		HGT_MAIN_MAX_BLOCKS		65536
+
+#define		HGT_ZERO_ITER_MAX		100		// steps per zero in ZeroRefine.c
+
+#define		HGT_STEP_RESYNC			64		// points between exact restarts
+#define		HGT_STEP_BLOCK			256		// terms per block in HardyZstep.c
+#define		HGT_STEP_GUARD_BITS		16		// extra bits for stepping
+#define		HGT_STEP_THETA_TERMS	64		// most Taylor terms for theta
+#define		HGT_STEP_WINDOW			4096	// points handed out at a time
+
+#define		HGT_BACKEND_DOUBLE		0		// see hgtBackend.c
+#define		HGT_BACKEND_DD			1
+#define		HGT_BACKEND_QUAD		2		// see hgtQuad.c
+#define		HGT_BACKEND_MPFR		3
+#define		HGT_PREC_GUARD_BITS		8		// see SelectPrecision
+#define		HGT_PREC_MIN_BITS		64
+
+#define		HGT_FIXED_LIMBS_MIN		2		// see hgtFixed.c
+#define		HGT_FIXED_LIMBS_MAX		4		// 256 bits
+
+#define		HGT_SIMD_SCALAR			0		// see hgtSimd.c
+#define		HGT_SIMD_AVX2			1
+#define		HGT_SIMD_AVX512			2
+
+#define		HGT_JOB_URGENT			0		// job priorities; see hgtJob.c
+#define		HGT_JOB_NORMAL			1
+#define		HGT_JOB_BULK			2
+#define		HGT_JOB_PRIORITIES		3
+#define		HGT_JOB_COUNT_MAX		1e7		// values per job (all held in memory)
+
+#define		HGT_AFFINITY_NONE		0		// see SetThreadAffinity
+#define		HGT_AFFINITY_CORE		1		// each worker on a CPU of its own
+#define		HGT_AFFINITY_NODE		2		// each worker on a NUMA node
+
+#define		HGT_INSTRUMENT_STATS	1		// see hgtStats.c
+#define		HGT_INSTRUMENT_TRACE	2
+#define		HGT_TRACE_EVENTS		4096	// events buffered per thread
+#define		HGT_TRACE_FILE			"hgt-trace.json"
+
+#define		HGT_STAGE_THETA			0		// stages timed by StatsStop
+#define		HGT_STAGE_MAIN			1
+#define		HGT_STAGE_REMAINDER		2
+#define		HGT_STAGE_CALLBACK		3
+#define		HGT_STAGE_IDLE			4
+#define		HGT_STAGE_POINT			5		// a whole HardyZSingle
+#define		HGT_STAGE_TASK			6		// a whole pool task
+#define		HGT_STAGE_BATCH			7		// a whole HardyZStream
+#define		HGT_STAGES				8
+
+#define		HGT_STAT_POINTS			0		// counters kept by StatsCount
+#define		HGT_STAT_TERMS			1		// RS_MainTerm terms summed
+#define		HGT_STAT_MPFR_OPS		2		// MPFR calls in those terms
+#define		HGT_STAT_TASKS			3		// pool tasks run
+#define		HGT_STAT_COUNTERS		4
+
 // -------------------------------------------------------------------
-// The last 4 debug flaga are reserved for the code that uses the
-// libhgt.a library.  The first two debug flags are reserved for the 
-// files making up the libhgt.a library.
+// The 4 RESERVED debug flaga are reserved for the code that uses the
+// libhgt.a library.  The others are used by the files making up the
+// libhgt.a library.
 // -------------------------------------------------------------------
 #define		PRINT_REMAINDER			2	// used in HardyZcalc.c
 #define		PRINT_COEFF				3	// used in RSbuildcoeff.c
@@ -107,33 +224,199 @@ struct computeHZ {
 #define		HGT_DEBUG_RESERVED2		7
 #define		HGT_DEBUG_RESERVED3		11
 #define		HGT_DEBUG_RESERVED4		13
+#define		HGT_DEBUG_STATS			17	// see hgtStats.c
+#define		HGT_DEBUG_TRACE			19
+
+// -------------------------------------------------------------------
+// A context holds everything that used to be process-wide: the
+// constants and precision (Init), the Gabcke coefficients at that
+// precision, the worker pool and its queued jobs.  Callers create one with
+// HgtContextCreate and make it current on a thread with HgtContextUse;
+// the fields are for the library's use only.  Each thread starts out
+// using the default context, which InitMPFR and CloseMPFR manage.
+// Inside the library, hgt_init names the current context's Init.
+// -------------------------------------------------------------------
+struct HGT_CONTEXT {				// see hgtInit.c
+	struct HGT_INIT		Init;
+	mpfr_t				Coeff[GABCKE_NUM_Cj_TERMS][GABCKE_COEFF_PER_Cj];
+	bool				HasCoeff;
+	struct HGT_POOL		*Pool;
+	struct HGT_JOBS		*Jobs;			// queued async jobs (hgtJob.c)
+};
+
+extern _Thread_local struct HGT_CONTEXT		*hgt_current;
+#define		hgt_init				(hgt_current->Init)
+
+struct HGT_STATS {					// see StatsRead
+	int			Thread;
+	uint64_t	Count[HGT_STAT_COUNTERS];
+	uint64_t	Ns[HGT_STAGES];		// time in each stage
+};
+
+struct HGT_FILE_HEADER {			// see hgtFile.c
+	char		Magic[8];			// "HGTZDAT1"
+	uint32_t	Version;
+	uint32_t	Format;				// HGT_FILE_DOUBLE or HGT_FILE_MPFR
+	uint32_t	Bits;				// MPFR precision of the run
+	uint32_t	LimbBytes;			// sizeof(mp_limb_t)
+	uint64_t	ValueSize;			// bytes per stored MPFR value
+	uint64_t	RecordSize;			// bytes per (t, Z) record
+	uint64_t	HeaderSize;			// offset of the first record
+	uint64_t	Count;				// records in the complete run
+	uint64_t	Committed;			// records known to be good
+	uint64_t	IndexOffset;		// offset of the index (0 until complete)
+	uint64_t	IndexStride;		// records per index entry
+	uint64_t	IndexEntries;
+};
 
 bool DebugMode(int iDebug, int DebugNum);
 int GetSmallPositiveInteger(const char *str, int Min, int Max);
+int64_t GetLargePositiveInteger(const char *str, int64_t Min, int64_t Max);
 int GetLargeNumber(const char *str, double Min, double Max, bool IntegerOnly);
 int GetDecimalDigits(const char *str);
 
 int InitMPFR(int DefaultBits, int MaxThreads, int DebugFlags, bool CalcHardy);
 int CloseMPFR(void);
-
-int	InitCoeffMPFR(int iFloatBits);
-int	CloseCoeffMPFR(void);
-int	BuildCoefficientsMPFR(void);
+struct HGT_CONTEXT * HgtContextCreate(int DefaultBits, int MaxThreads, 
+	int DebugFlags, bool CalcHardy);
+int HgtContextFree(struct HGT_CONTEXT *Context);
+struct HGT_CONTEXT * HgtContextUse(struct HGT_CONTEXT *Context);
+
+struct HGT_POOL * PoolCreate(struct HGT_CONTEXT *Context, int Workers);
+int PoolDestroy(struct HGT_POOL *Pool);
+int PoolWorkers(void);
+int HardwareThreads(void);
+int SetThreadAffinity(int Mode);
+struct HGT_BATCH * PoolBatchCreate(void);
+int PoolBatchFree(struct HGT_BATCH *Batch);
+int PoolSubmit(struct HGT_BATCH *Batch, pPoolTask Func, void *Arg);
+int PoolWaitBatch(struct HGT_BATCH *Batch);
+int PoolItemDone(struct HGT_BATCH *Batch, int *Done);
+bool PoolItemReady(struct HGT_BATCH *Batch, int *Done);
+int PoolWaitItem(struct HGT_BATCH *Batch, int *Done);
+bool PoolHelp(struct HGT_BATCH *Batch);
+
+struct HGT_JOBS * JobsCreate(void);
+int JobsFree(struct HGT_JOBS *Jobs);
+struct HGT_JOB * JobHardyZ(mpfr_t t, mpfr_t Incr, uint64_t Count, int Priority,
+	struct HGT_QUEUE *Queue);
+struct HGT_JOB * JobGramAtN(mpfr_t N, mpfr_t Accuracy, int Priority,
+	struct HGT_QUEUE *Queue);
+struct HGT_JOB * JobGramRange(mpfr_t N, uint64_t Count, mpfr_t Accuracy,
+	int Priority, struct HGT_QUEUE *Queue);
+bool JobReady(struct HGT_JOB *Job);
+int JobWait(struct HGT_JOB *Job);
+uint64_t JobCount(struct HGT_JOB *Job);
+int JobValue(struct HGT_JOB *Job, uint64_t i, mpfr_t *Value, double *Radius);
+int JobFree(struct HGT_JOB *Job);
+struct HGT_QUEUE * JobQueueCreate(void);
+int JobQueueFree(struct HGT_QUEUE *Queue);
+struct HGT_JOB * JobQueueNext(struct HGT_QUEUE *Queue, bool Wait);
+
+struct HGT_WORKMARK WorkMark(void);
+void WorkInits(int Bits, mpfr_ptr x, ...);
+void WorkRelease(struct HGT_WORKMARK Mark);
+void WorkFree(void);
+
+struct HGT_RING * RingCreate(uint64_t Size);
+int RingFree(struct HGT_RING *Ring);
+int RingPublish(struct HGT_RING *Ring, uint64_t Index);
+int RingWait(struct HGT_RING *Ring, uint64_t Index, struct HGT_BATCH *Batch);
+
+uint64_t StatsStart(void);
+void StatsStop(int Stage, uint64_t Start);
+void StatsCount(int Counter, uint64_t n);
+int StatsRead(struct HGT_STATS *Stats, int Max);
+int StatsReset(void);
+int StatsTraceOpen(const char *FileName);
+int StatsTraceClose(void);
+void StatsThreadExit(void);
+
+int	InitCoeffMPFR(struct HGT_CONTEXT *Context);
+int	CloseCoeffMPFR(struct HGT_CONTEXT *Context);
+int	FreeCoefficientCache(void);
+int	BuildCoefficientsMPFR(struct HGT_CONTEXT *Context);
+int	BuildRemainderBounds(void);
 int	CoeffStrToMPFR(mpfr_t *Result, const char *strCoeff);
+int	CoeffBinToMPFR(mpfr_t *Result, int Cj, int k);
+int	BuildCoefficientsDD(void);
+int	BuildCoefficientsQuad(void);
+int	MPFRToTripleDouble(double Parts[3], mpfr_t x);
+
+int SelectBackend(mpfr_t t, int Digits);
+int SelectPrecision(mpfr_t t, int Digits);
+int SetAccuracyDigits(int Digits);
+int ThetaOfT_Double(mpfr_t *Theta, mpfr_t t);
+int RS_MainTerm_Double(mpfr_t *Result, mpfr_t t, uint64_t N);
+int RS_Remainder_Double(mpfr_t *Result, mpfr_t tOver2Pi, bool nEven, mpfr_t P);
+int HardyZ_Double(mpfr_t *Result, mpfr_t t);
+int ThetaOfT_DD(mpfr_t *Theta, mpfr_t t);
+int RS_MainTerm_DD(mpfr_t *Result, mpfr_t t, uint64_t N);
+int RS_Remainder_DD(mpfr_t *Result, mpfr_t tOver2Pi, bool nEven, mpfr_t P);
+int HardyZ_DD(mpfr_t *Result, mpfr_t t);
+int ThetaOfT_Quad(mpfr_t *Theta, mpfr_t t);
+int RS_MainTerm_Quad(mpfr_t *Result, mpfr_t t, uint64_t N);
+int RS_Remainder_Quad(mpfr_t *Result, mpfr_t tOver2Pi, bool nEven, mpfr_t P);
+int HardyZ_Quad(mpfr_t *Result, mpfr_t t);
+
+int BuildSimdTables(void);
+int SetSimdLevel(int Level);
+int SimdLevel(void);
+int MainSumDouble(double Sum[2], const double t[2], const double Theta[2],
+	uint64_t nFirst, uint64_t nLast);
+
+int BuildFixedTables(void);
+int FreeFixedTables(void);
+bool FixedUsable(int Bits);
+int SetFixedPoint(bool On);
+int MainSumFixed(mpfr_t Sum, mpfr_t t, mpfr_t Theta, uint64_t nFirst,
+	uint64_t nLast, int Bits);
+
+int TableOpen(const char *Dir, int Backend);
+int TableClose(int Backend);
+const void *TableAcquire(int Backend, int Bits, uint64_t N);
+int TableRelease(int Backend);
+int TableViewMPFR(const void *Entries, uint64_t n, mpfr_t Log, mpfr_t RecipSqrt);
 
 int ThetaOfT(mpfr_t *Theta, mpfr_t t);
+int ThetaOfTPrec(mpfr_t *Theta, mpfr_t t, int iFloatBits);
+int ThetaPrimeOfT(mpfr_t *ThetaPrime, mpfr_t t);
+int ThetaPairOfT(mpfr_t *Theta, mpfr_t *ThetaPrime, mpfr_t t);
 int GramAtN(mpfr_t *Result, mpfr_t N, mpfr_t Accuracy);
+int GramRange(mpfr_t *Results, mpfr_t N, uint64_t Count, mpfr_t Accuracy);
 int GramNearT(mpfr_t *Result, mpfr_t T);
 int RS_MainTerm(mpfr_t *Result, mpfr_t t, uint64_t N, int iFloatBits);
+int RS_MainTermDeriv(mpfr_t *Result, mpfr_t *Deriv, mpfr_t t, uint64_t N, int iFloatBits);
 int RS_Remainder(mpfr_t *Result, mpfr_t tOver2Pi, bool nEven, mpfr_t P, int iFloatBits);
+int RS_RemainderDeriv(mpfr_t *Result, mpfr_t *Deriv, mpfr_t tOver2Pi, bool nEven, 
+	mpfr_t P, int iFloatBits);
+double RS_MainTermBound(double t, uint64_t N, int iFloatBits);
+double RS_RemainderBound(double tOver2Pi, int iFloatBits);
 
 int HardyZWithCount(mpfr_t t, mpfr_t Incr, int Count, int CallerID, pHardyZCallback pCallbackHZ);
+int HardyZWithRange(mpfr_t t, mpfr_t Incr, uint64_t Count, int CallerID, 
+	pHardyZRangeCallback pCallbackRange);
+int HardyZWithBall(mpfr_t t, mpfr_t Incr, uint64_t Count, int CallerID, 
+	pHardyZBallCallback pCallbackBall);
+int HardyZBallSign(mpfr_t Z, double Radius);
+int HardyZWithGrid(mpfr_t t, mpfr_t Incr, uint64_t Count, int CallerID, 
+	pHardyZRangeCallback pCallbackRange);
+int HardyZWithStep(mpfr_t t, mpfr_t Incr, uint64_t Count, int CallerID, 
+	pHardyZRangeCallback pCallbackRange);
 void * HardyZSingleThreaded(void * comphz);
 int HardyZSingle(struct computeHZ * comphz);
+int HardyZSingleBall(struct computeHZ * comphz);
+int HardyZToFile(const char *FileName, mpfr_t t, mpfr_t Incr, uint64_t Count,
+	int Format, int CallerID, pHardyZRangeCallback pCallbackRange);
+int HardyZFileView(const void *Map, uint64_t Index, mpfr_t t, mpfr_t Z);
+int HardyZSingleDeriv(struct computeHZ * comphz, mpfr_t Deriv);
+int HardyZRefineZero(mpfr_t *Root, mpfr_t a, mpfr_t b, mpfr_t Tol, int *Evals);
+int HardyZFindZeros(mpfr_t a, mpfr_t b, int Samples, mpfr_t Tol, int CallerID, 
+	pHardyZCallback pCallbackHZ);
 
 int ValidateHardyT(const char *str);
 int ValidateIncr(const char *str);
-int ValidateCount(const char *str);
+int64_t ValidateCount(const char *str);
 int ValidateThreads(const char *str);
 int ValidateDebugFlags(const char *str);
 int ValidatePrecisionMPFR(const char *str);
@@ -143,6 +426,9 @@ int ValidateGramN(const char *str);
 int ValidateGramT(const char *str);
 int ValidateGramAccuracy(const char *str);
 
+int TuringVerify(mpfr_t N, uint64_t Count, int GramPts, int SubIntvl,
+	struct HGT_TURING *Result);
+
 int ValidateTuringGramPoints(const char *str);
 int ValidateTuringSubIntervals(const char *str);
 
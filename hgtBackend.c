@@ -0,0 +1,667 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file holds the fast numeric backends that sit under HardyZSingle
+// and the backend selector.  The MPFR code (ThetaOfT, RS_MainTerm and
+// RS_Remainder) remains the reference implementation.  Here we give
+// the same three computations in:
+//
+//	 (1) double -- every operation in double precision, except that the
+//		 phase theta(t) - t log n is formed and reduced modulo 2 pi in
+//		 double-double, since t log n is far larger than 1;
+//	 (2) double-double -- every operation in double-double (about 106
+//		 bits), as an unevaluated sum hi + lo of two doubles;
+//	 (3) __float128 -- see hgtQuad.c.
+//
+// SelectBackend picks the cheapest backend whose estimated error in
+// Z(t) is below 10^{-Digits}, based on the unit roundoff of each
+// backend, the size of t log N and the number of terms N.
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+// A double-double value hi + lo, with |lo| <= ulp(hi) / 2.
+// -------------------------------------------------------------------
+typedef struct {
+	double		hi;
+	double		lo;
+} dd_t;
+
+// -------------------------------------------------------------------
+// Constants and Gabcke coefficients for the double and double-double
+// backends.  These are built from MPFR values by BuildCoefficientsDD.
+// -------------------------------------------------------------------
+static double	ddTwoPi[3];			// 2 pi as three doubles
+static dd_t		ddPiOver2, ddPiOver8, ddLog2, ddTwoPiDD;
+static dd_t		ddCoeff[GABCKE_NUM_Cj_TERMS][GABCKE_COEFF_PER_Cj];
+static double	dCoeff[GABCKE_NUM_Cj_TERMS][GABCKE_COEFF_PER_Cj];
+static bool		ddReady = false;
+
+// -------------------------------------------------------------------
+// Error-free transformations and basic double-double arithmetic.
+// -------------------------------------------------------------------
+static inline dd_t DDQuickTwoSum(double a, double b)
+{
+dd_t	r;
+
+r.hi = a + b;
+r.lo = b - (r.hi - a);
+return(r);
+}
+
+static inline dd_t DDTwoSum(double a, double b)
+{
+dd_t	r;
+double	bb;
+
+r.hi = a + b;
+bb   = r.hi - a;
+r.lo = (a - (r.hi - bb)) + (b - bb);
+return(r);
+}
+
+static inline dd_t DDTwoProd(double a, double b)
+{
+dd_t	r;
+
+r.hi = a * b;
+r.lo = fma(a, b, -r.hi);
+return(r);
+}
+
+static inline dd_t DDFromD(double a)
+{
+dd_t	r = { a, 0.0 };
+
+return(r);
+}
+
+static inline dd_t DDAdd(dd_t a, dd_t b)
+{
+dd_t	s, t;
+
+s = DDTwoSum(a.hi, b.hi);
+t = DDTwoSum(a.lo, b.lo);
+s.lo += t.hi;
+s = DDQuickTwoSum(s.hi, s.lo);
+s.lo += t.lo;
+return(DDQuickTwoSum(s.hi, s.lo));
+}
+
+static inline dd_t DDNeg(dd_t a)
+{
+dd_t	r = { -a.hi, -a.lo };
+
+return(r);
+}
+
+static inline dd_t DDSub(dd_t a, dd_t b)
+{
+return(DDAdd(a, DDNeg(b)));
+}
+
+static inline dd_t DDAddD(dd_t a, double b)
+{
+dd_t	s;
+
+s = DDTwoSum(a.hi, b);
+s.lo += a.lo;
+return(DDQuickTwoSum(s.hi, s.lo));
+}
+
+static inline dd_t DDMul(dd_t a, dd_t b)
+{
+dd_t	p;
+
+p = DDTwoProd(a.hi, b.hi);
+p.lo += a.hi * b.lo + a.lo * b.hi;
+return(DDQuickTwoSum(p.hi, p.lo));
+}
+
+static inline dd_t DDMulD(dd_t a, double b)
+{
+dd_t	p;
+
+p = DDTwoProd(a.hi, b);
+p.lo += a.lo * b;
+return(DDQuickTwoSum(p.hi, p.lo));
+}
+
+static inline dd_t DDDivD(dd_t a, double b)
+{
+dd_t	p, r;
+double	q1, q2;
+
+q1 = a.hi / b;
+p  = DDTwoProd(q1, b);
+r  = DDSub(a, p);
+q2 = r.hi / b;
+return(DDQuickTwoSum(q1, q2));
+}
+
+static inline dd_t DDDiv(dd_t a, dd_t b)
+{
+dd_t	r;
+double	q1, q2, q3;
+
+q1 = a.hi / b.hi;
+r  = DDSub(a, DDMulD(b, q1));
+q2 = r.hi / b.hi;
+r  = DDSub(r, DDMulD(b, q2));
+q3 = r.hi / b.hi;
+r  = DDQuickTwoSum(q1, q2);
+return(DDAddD(r, q3));
+}
+
+static inline dd_t DDSqrt(dd_t a)
+{
+double	s;
+
+if(a.hi <= 0.0) {
+	return(DDFromD(0.0));
+	}
+s = sqrt(a.hi);
+return(DDAddD(DDFromD(s), DDSub(a, DDTwoProd(s, s)).hi / (2.0 * s)));
+}
+
+// -------------------------------------------------------------------
+// exp(a): write a = k log 2 + r, then use the Taylor series for
+// expm1(r / 512) and square back up nine times.
+// -------------------------------------------------------------------
+static dd_t DDExp(dd_t a)
+{
+dd_t	r, s, p;
+double	k;
+int		i;
+
+k = nearbyint(a.hi / ddLog2.hi);
+r = DDSub(a, DDMul(ddLog2, DDFromD(k)));
+r.hi = ldexp(r.hi, -9);
+r.lo = ldexp(r.lo, -9);
+
+s = r;
+p = r;
+for(i = 2; i <= 11; i++) {
+	p = DDDivD(DDMul(p, r), (double) i);
+	s = DDAdd(s, p);
+	}
+for(i = 0; i < 9; i++) {			// expm1(2x) = expm1(x) (expm1(x) + 2)
+	s = DDMul(s, DDAddD(s, 2.0));
+	}
+s = DDAddD(s, 1.0);
+s.hi = ldexp(s.hi, (int) k);
+s.lo = ldexp(s.lo, (int) k);
+return(s);
+}
+
+// -------------------------------------------------------------------
+// log(a), a > 0: one Newton step x + a e^{-x} - 1 from x = log(a.hi).
+// -------------------------------------------------------------------
+static dd_t DDLog(dd_t a)
+{
+double	x;
+
+x = log(a.hi);
+return(DDAdd(DDFromD(x), DDAddD(DDMul(a, DDExp(DDFromD(-x))), -1.0)));
+}
+
+// -------------------------------------------------------------------
+// Reduce a modulo 2 pi to [-pi, pi].  The products k * (2 pi) use the
+// three-double value of 2 pi, so the result is good to double-double
+// precision relative to a itself.
+// -------------------------------------------------------------------
+static dd_t DDReduce2Pi(dd_t a)
+{
+dd_t	r;
+double	k;
+
+k = nearbyint(a.hi / ddTwoPi[0]);
+r = DDSub(a, DDTwoProd(k, ddTwoPi[0]));
+r = DDSub(r, DDTwoProd(k, ddTwoPi[1]));
+r = DDAddD(r, -k * ddTwoPi[2]);
+return(r);
+}
+
+// -------------------------------------------------------------------
+// Taylor series for sin and cos of a value in [-pi/4, pi/4].
+// -------------------------------------------------------------------
+static void DDSinCosSmall(dd_t r, dd_t *Sin, dd_t *Cos)
+{
+dd_t	r2, term, s, c;
+int		i;
+
+r2 = DDMul(r, r);
+s = r;
+c = DDFromD(1.0);
+term = r;
+for(i = 1; fabs(term.hi) > 1e-34; i++) {		// sin: r^{2i+1} / (2i+1)!
+	term = DDDivD(DDMul(term, r2), -(double) ((2 * i) * (2 * i + 1)));
+	s = DDAdd(s, term);
+	}
+term = DDFromD(1.0);
+for(i = 1; fabs(term.hi) > 1e-34; i++) {		// cos: r^{2i} / (2i)!
+	term = DDDivD(DDMul(term, r2), -(double) ((2 * i - 1) * (2 * i)));
+	c = DDAdd(c, term);
+	}
+*Sin = s;
+*Cos = c;
+}
+
+// -------------------------------------------------------------------
+// cos(a) for any a, by reduction modulo 2 pi and then to a quadrant.
+// -------------------------------------------------------------------
+static dd_t DDCos(dd_t a)
+{
+dd_t	r, s, c;
+int		j;
+
+r = DDReduce2Pi(a);
+j = (int) nearbyint(r.hi / ddPiOver2.hi);
+r = DDSub(r, DDMulD(ddPiOver2, (double) j));
+DDSinCosSmall(r, &s, &c);
+switch(((j % 4) + 4) % 4) {
+	case 0:		return(c);
+	case 1:		return(DDNeg(s));
+	case 2:		return(DDNeg(c));
+	default:	return(s);
+	}
+}
+
+// -------------------------------------------------------------------
+// Conversions between MPFR and double-double.
+// -------------------------------------------------------------------
+static dd_t DDFromMPFR(mpfr_t x)
+{
+mpfr_t	Temp1;
+dd_t	r;
+
+mpfr_init2 (Temp1, mpfr_get_prec(x));
+r.hi = mpfr_get_d (x, MPFR_RNDN);
+mpfr_sub_d (Temp1, x, r.hi, MPFR_RNDN);
+r.lo = mpfr_get_d (Temp1, MPFR_RNDN);
+mpfr_clear (Temp1);
+return(r);
+}
+
+static void DDToMPFR(mpfr_t *Result, dd_t a)
+{
+mpfr_set_d (*Result, a.hi, MPFR_RNDN);
+mpfr_add_d (*Result, *Result, a.lo, MPFR_RNDN);
+}
+
+// -------------------------------------------------------------------
+// Build the constants and the Gabcke coefficients for the double and
+// double-double backends from 256-bit MPFR values.  This is called by
+// InitCoeffMPFR.
+// -------------------------------------------------------------------
+int BuildCoefficientsDD(void)
+{
+mpfr_t	Pi, Temp1;
+double	Parts[3];
+int		i, j;
+
+mpfr_inits2 (256, Pi, Temp1, (mpfr_ptr) 0);
+mpfr_const_pi (Pi, MPFR_RNDN);
+
+mpfr_mul_2ui (Temp1, Pi, 1, MPFR_RNDN);
+MPFRToTripleDouble(Parts, Temp1);
+ddTwoPi[0] = Parts[0];
+ddTwoPi[1] = Parts[1];
+ddTwoPi[2] = Parts[2];
+ddTwoPiDD = DDFromMPFR(Temp1);
+
+mpfr_div_2ui (Temp1, Pi, 1, MPFR_RNDN);
+ddPiOver2 = DDFromMPFR(Temp1);
+mpfr_div_2ui (Temp1, Pi, 3, MPFR_RNDN);
+ddPiOver8 = DDFromMPFR(Temp1);
+mpfr_const_log2 (Temp1, MPFR_RNDN);
+ddLog2 = DDFromMPFR(Temp1);
+
+for(j = 0; j < GABCKE_NUM_Cj_TERMS; j++) {
+	for(i = 0; i < GABCKE_COEFF_PER_Cj; i++) {
+		CoeffBinToMPFR(&Temp1, j, i);
+		ddCoeff[j][i] = DDFromMPFR(Temp1);
+		dCoeff[j][i]  = ddCoeff[j][i].hi;
+		}
+	}
+mpfr_clears (Pi, Temp1, (mpfr_ptr) 0);
+ddReady = true;
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Split an MPFR value into three non-overlapping doubles.
+// -------------------------------------------------------------------
+int MPFRToTripleDouble(double Parts[3], mpfr_t x)
+{
+mpfr_t	Temp1;
+
+mpfr_init2 (Temp1, mpfr_get_prec(x));
+mpfr_set (Temp1, x, MPFR_RNDN);
+Parts[0] = mpfr_get_d (Temp1, MPFR_RNDN);
+mpfr_sub_d (Temp1, Temp1, Parts[0], MPFR_RNDN);
+Parts[1] = mpfr_get_d (Temp1, MPFR_RNDN);
+mpfr_sub_d (Temp1, Temp1, Parts[1], MPFR_RNDN);
+Parts[2] = mpfr_get_d (Temp1, MPFR_RNDN);
+mpfr_clear (Temp1);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// theta(t) in double-double, using the same formula as ThetaOfT:
+//    Theta = tOver2 * [LogOftOver2Pi - 1] + Recip48t - PiOver8 + Power3Term
+// -------------------------------------------------------------------
+static dd_t DDTheta(dd_t t)
+{
+dd_t	tOver2, Theta, Minor;
+
+tOver2 = DDMulD(t, 0.5);
+Theta  = DDMul(tOver2, DDAddD(DDLog(DDDiv(t, ddTwoPiDD)), -1.0));
+Minor  = DDSub(DDDiv(DDFromD(1.0), DDMulD(t, 48.0)), ddPiOver8);
+if(t.hi < THETA_MAX_T_POWER3) {
+	Minor = DDAdd(Minor, DDDiv(DDDivD(DDFromD(7.0), 5760.0), DDMul(t, DDMul(t, t))));
+	}
+return(DDAdd(Theta, Minor));
+}
+
+// -------------------------------------------------------------------
+// N, P and (t / 2 pi)^{-1/4} for the given t, in double-double.
+// -------------------------------------------------------------------
+static uint64_t DDSplitT(dd_t t, dd_t *P, dd_t *tFraction)
+{
+dd_t		tOver2Pi, Root;
+uint64_t	N;
+
+tOver2Pi = DDDiv(t, ddTwoPiDD);
+Root	 = DDSqrt(tOver2Pi);
+N		 = (uint64_t) floor(Root.hi);
+*P		 = DDAddD(Root, -(double) N);
+if(P->hi < 0.0) {					// Root.hi is an integer, Root.lo < 0
+	N--;
+	*P = DDAddD(*P, 1.0);
+	}
+*tFraction = DDSqrt(DDDiv(DDFromD(1.0), Root));
+return(N);
+}
+
+// *******************************************************************
+// The double backend.
+// *******************************************************************
+
+// -------------------------------------------------------------------
+// theta(t) in double backend: the phase needs double-double, so we
+// return theta in double-double form.
+// -------------------------------------------------------------------
+int ThetaOfT_Double(mpfr_t *Theta, mpfr_t t)
+{
+DDToMPFR(Theta, DDTheta(DDFromMPFR(t)));
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Main term in double: the phase theta(t) - t log n is formed and
+// reduced modulo 2 pi in double-double, and the rest (cos, 1/sqrt(n)
+// and the compensated sum) is done in double.  The n-loop is the
+// vector kernel in hgtSimd.c.
+// -------------------------------------------------------------------
+static double MainTermDouble(dd_t t, dd_t Theta, uint64_t N)
+{
+double		tParts[2] = { t.hi, t.lo }, ThetaParts[2] = { Theta.hi, Theta.lo };
+double		Sum[2];
+
+MainSumDouble(Sum, tParts, ThetaParts, 1, N);
+return(2.0 * (Sum[0] + Sum[1]));
+}
+
+int RS_MainTerm_Double(mpfr_t *Result, mpfr_t t, uint64_t N)
+{
+dd_t	ddt = DDFromMPFR(t);
+
+if(N < 1) {
+	mpfr_set_ui (*Result, 0, MPFR_RNDN);
+	return(1);
+	}
+mpfr_set_d (*Result, MainTermDouble(ddt, DDTheta(ddt), N), MPFR_RNDN);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Remainder in double: Factor * SUM_j tFraction^{2j} Cj(AdjP), with
+// each Cj evaluated by Horner's rule in AdjP^2.
+// -------------------------------------------------------------------
+static double RemainderDouble(double tFraction, bool nEven, double P)
+{
+double		AdjP, AdjP2, Cj, Total = 0.0, tPower = 1.0;
+int			i, j;
+
+AdjP  = 1.0 - 2.0 * P;
+AdjP2 = AdjP * AdjP;
+for(j = 0; j < GABCKE_NUM_Cj_TERMS; j++) {
+	Cj = 0.0;
+	for(i = GABCKE_COEFF_PER_Cj - 1; i >= 0; i--) {
+		Cj = fma(Cj, AdjP2, dCoeff[j][i]);
+		}
+	if(j % 2 == 1) {
+		Cj *= AdjP;
+		}
+	Total  = fma(tPower, Cj, Total);
+	tPower *= tFraction * tFraction;
+	}
+return(nEven == true ? -tFraction * Total : tFraction * Total);
+}
+
+int RS_Remainder_Double(mpfr_t *Result, mpfr_t tOver2Pi, bool nEven, mpfr_t P)
+{
+double	tFraction;
+
+tFraction = sqrt(1.0 / sqrt(mpfr_get_d (tOver2Pi, MPFR_RNDN)));
+mpfr_set_d (*Result, RemainderDouble(tFraction, nEven, mpfr_get_d (P, MPFR_RNDN)), MPFR_RNDN);
+return(1);
+}
+
+int HardyZ_Double(mpfr_t *Result, mpfr_t t)
+{
+dd_t		ddt, P, tFraction;
+uint64_t	N;
+
+ddt = DDFromMPFR(t);
+N	= DDSplitT(ddt, &P, &tFraction);
+mpfr_set_d (*Result, MainTermDouble(ddt, DDTheta(ddt), N)
+	+ RemainderDouble(tFraction.hi, N % 2 == 0, P.hi), MPFR_RNDN);
+return(1);
+}
+
+// *******************************************************************
+// The double-double backend.
+// *******************************************************************
+int ThetaOfT_DD(mpfr_t *Theta, mpfr_t t)
+{
+DDToMPFR(Theta, DDTheta(DDFromMPFR(t)));
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Main term in double-double.  If a double-double log(n) / 1/sqrt(n)
+// table is open (see hgtTable.c), we take those values from it.
+// -------------------------------------------------------------------
+static dd_t MainTermDD(dd_t t, dd_t Theta, uint64_t N)
+{
+dd_t		Sum, Phase, nDD, Log, Recip;
+const double	*Table;
+uint64_t	n;
+
+Table = TableAcquire(HGT_BACKEND_DD, 0, N);
+Sum = DDCos(Theta);
+for(n = 2; n <= N; n++) {
+	if(Table != NULL) {
+		Log.hi	 = Table[4 * (n - 1)];
+		Log.lo	 = Table[4 * (n - 1) + 1];
+		Recip.hi = Table[4 * (n - 1) + 2];
+		Recip.lo = Table[4 * (n - 1) + 3];
+		}
+	else {
+		nDD	  = DDFromD((double) n);
+		Log	  = DDLog(nDD);
+		Recip = DDDiv(DDFromD(1.0), DDSqrt(nDD));
+		}
+	Phase = DDSub(Theta, DDMul(t, Log));
+	Sum   = DDAdd(Sum, DDMul(DDCos(Phase), Recip));
+	}
+if(Table != NULL) {
+	TableRelease(HGT_BACKEND_DD);
+	}
+return(DDMulD(Sum, 2.0));
+}
+
+int RS_MainTerm_DD(mpfr_t *Result, mpfr_t t, uint64_t N)
+{
+dd_t	ddt = DDFromMPFR(t);
+
+if(N < 1) {
+	mpfr_set_ui (*Result, 0, MPFR_RNDN);
+	return(1);
+	}
+DDToMPFR(Result, MainTermDD(ddt, DDTheta(ddt), N));
+return(1);
+}
+
+static dd_t RemainderDD(dd_t tFraction, bool nEven, dd_t P)
+{
+dd_t		AdjP, AdjP2, Cj, Total, tPower, tFraction2;
+int			i, j;
+
+AdjP	   = DDAddD(DDMulD(P, -2.0), 1.0);
+AdjP2	   = DDMul(AdjP, AdjP);
+tFraction2 = DDMul(tFraction, tFraction);
+tPower	   = DDFromD(1.0);
+Total	   = DDFromD(0.0);
+for(j = 0; j < GABCKE_NUM_Cj_TERMS; j++) {
+	Cj = DDFromD(0.0);
+	for(i = GABCKE_COEFF_PER_Cj - 1; i >= 0; i--) {
+		Cj = DDAdd(DDMul(Cj, AdjP2), ddCoeff[j][i]);
+		}
+	if(j % 2 == 1) {
+		Cj = DDMul(Cj, AdjP);
+		}
+	Total  = DDAdd(Total, DDMul(tPower, Cj));
+	tPower = DDMul(tPower, tFraction2);
+	}
+Total = DDMul(tFraction, Total);
+return(nEven == true ? DDNeg(Total) : Total);
+}
+
+int RS_Remainder_DD(mpfr_t *Result, mpfr_t tOver2Pi, bool nEven, mpfr_t P)
+{
+dd_t	tFraction;
+
+tFraction = DDSqrt(DDDiv(DDFromD(1.0), DDSqrt(DDFromMPFR(tOver2Pi))));
+DDToMPFR(Result, RemainderDD(tFraction, nEven, DDFromMPFR(P)));
+return(1);
+}
+
+int HardyZ_DD(mpfr_t *Result, mpfr_t t)
+{
+dd_t		ddt, P, tFraction;
+uint64_t	N;
+
+ddt = DDFromMPFR(t);
+N	= DDSplitT(ddt, &P, &tFraction);
+DDToMPFR(Result, DDAdd(MainTermDD(ddt, DDTheta(ddt), N),
+	RemainderDD(tFraction, N % 2 == 0, P)));
+return(1);
+}
+
+// *******************************************************************
+// Backend selection.
+// *******************************************************************
+
+// -------------------------------------------------------------------
+// Estimated absolute error in Z(t) for a backend with unit roundoff
+// Unit, when the phase is formed with unit roundoff PhaseUnit.  The
+// phase theta(t) - t log n is about Phi = t (log N + log(t / 2 pi) / 2)
+// in size, and the sum has weight SUM n^{-1/2} <= 2 sqrt(N).
+// -------------------------------------------------------------------
+static double BackendError(double t, double Unit, double PhaseUnit)
+{
+double	N, Phi, Weight;
+
+N	   = floor(sqrt(t / (2.0 * M_PI)));
+N	   = N < 1.0 ? 1.0 : N;
+Phi	   = t * (log(N) + 0.5 * log(t / (2.0 * M_PI)) + 1.0);
+Weight = 2.0 * sqrt(N);
+return(2.0 * Weight * (8.0 * PhaseUnit * Phi + 8.0 * Unit));
+}
+
+// -------------------------------------------------------------------
+// Pick the cheapest backend that gives Digits correct decimal places.
+// -------------------------------------------------------------------
+int SelectBackend(mpfr_t t, int Digits)
+{
+double	dt, Target;
+
+if(Digits <= 0 || ddReady == false) {
+	return(HGT_BACKEND_MPFR);
+	}
+dt	   = mpfr_get_d (t, MPFR_RNDN);
+Target = pow(10.0, -Digits);
+
+if(BackendError(dt, ldexp(1.0, -53), ldexp(1.0, -106)) < Target) {
+	return(HGT_BACKEND_DOUBLE);
+	}
+if(BackendError(dt, ldexp(1.0, -106), ldexp(1.0, -106)) < Target) {
+	return(HGT_BACKEND_DD);
+	}
+if(BackendError(dt, ldexp(1.0, -113), ldexp(1.0, -113)) < Target) {
+	return(HGT_BACKEND_QUAD);
+	}
+return(HGT_BACKEND_MPFR);
+}
+
+// -------------------------------------------------------------------
+// The MPFR working precision that gives Digits correct decimal places
+// at t, by the same error estimate as the backends: the error is
+// about BackendError(t, 1, 1) units in the last place, so we need
+// log2 of that, plus log2(10^Digits), plus HGT_PREC_GUARD_BITS.  We
+// round up to whole limbs (which cost no more) and never go above the
+// context's precision, which the constants and coefficients have.
+// -------------------------------------------------------------------
+int SelectPrecision(mpfr_t t, int Digits)
+{
+double	dt;
+int		Bits;
+
+if(Digits <= 0) {
+	return(hgt_init.DefaultBits);
+	}
+dt	 = mpfr_get_d (t, MPFR_RNDN);
+Bits = (int) ceil(log2(BackendError(dt, 1.0, 1.0)) + Digits * log2(10.0))
+		+ HGT_PREC_GUARD_BITS;
+Bits = (Bits + mp_bits_per_limb - 1) / mp_bits_per_limb * mp_bits_per_limb;
+Bits = Bits < HGT_PREC_MIN_BITS ? HGT_PREC_MIN_BITS : Bits;
+return(Bits < hgt_init.DefaultBits ? Bits : hgt_init.DefaultBits);
+}
+
+// -------------------------------------------------------------------
+// Set the number of correct decimal digits required of Z(t).  Zero
+// (the default) means every point uses the MPFR reference code at
+// the full precision.
+// -------------------------------------------------------------------
+int SetAccuracyDigits(int Digits)
+{
+hgt_init.AccuracyDigits = Digits < 0 ? 0 : Digits;
+return(1);
+}
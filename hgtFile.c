@@ -0,0 +1,409 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <mpfr.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file writes Hardy Z values to a binary result file, and can
+// pick up an interrupted run where it left off.  The file is:
+//
+//		struct HGT_FILE_HEADER (padded to HGT_FILE_FIXED bytes)
+//		the start t, Incr and the next t, as MPFR values
+//		(padding to HeaderSize)
+//		Count records of (t, Z)
+//		the index: IndexEntries doubles (see below)
+//
+// An MPFR value is stored as in the log table (see hgtTable.c): its
+// kind and exponent (as int64_t) and then its limbs, ValueSize bytes
+// in all.  In an HGT_FILE_MPFR file, a record is two such values; in
+// an HGT_FILE_DOUBLE file it is two doubles.  Every field is a
+// multiple of 8 bytes, so the file can be memory-mapped and used in
+// place (see HardyZFileView).  The index holds the t of every
+// IndexStride-th record (as a double), to find a record by t.
+//
+// Every HGT_FILE_CHECKPOINT records we flush the file to disk, and
+// then update Committed and the next t in the header (and flush
+// again).  After a crash, the file holds at least Committed good
+// records, and we start again from there.  The t values are made by
+// repeated addition of Incr, as in HardyZWithRange, and the next t is
+// stored exactly, so a resumed run gives the same file as one that
+// was never interrupted.
+// -------------------------------------------------------------------
+
+#define		FILE_MAGIC		"HGTZDAT1"
+#define		FILE_VERSION	1
+
+struct fileValue {					// as struct tableValue in hgtTable.c
+	int64_t		Kind;
+	int64_t		Exp;
+	// followed by the limbs
+};
+
+struct hgtSink {
+	FILE					*File;
+	struct HGT_FILE_HEADER	Header;
+	unsigned char			*Record;
+	mpfr_t					Start, Incr, Next;
+	uint64_t				Base;		// record number of this run's point 0
+	pHardyZRangeCallback	pCallbackRange;
+	int						Error;
+};
+
+// the sink that FileCallback writes to (one per calling thread)
+static _Thread_local struct hgtSink	*activeSink = NULL;
+
+static int	FileCallback(mpfr_t t, mpfr_t z, uint64_t i, int CallerID);
+static int	FileCheckpoint(struct hgtSink *sink, uint64_t Committed);
+static int	FileWriteHeader(struct hgtSink *sink);
+static int	FileReadHeader(struct hgtSink *sink);
+static int	FileWriteIndex(struct hgtSink *sink);
+static int	FileSync(FILE *File);
+static void	FilePutMPFR(unsigned char *Dest, size_t ValueSize, int Bits, mpfr_t x);
+static void	FileGetMPFR(mpfr_t x, const unsigned char *Src, int Bits);
+
+// *******************************************************************
+// Compute Z at t, t + Incr, ... (Count values, as HardyZWithRange)
+// and write them to the result file FileName in the given Format
+// (HGT_FILE_DOUBLE or HGT_FILE_MPFR).  If the file holds part of the
+// same run (same t, Incr, Count, Format and precision), we go on from
+// its last committed record; if it holds all of it, we do nothing.
+// pCallbackRange may be NULL; if not, it is also given each new point.
+// Returns 1 on success, and 0 if the file cannot be written or holds
+// a different run (which we leave alone).
+// *******************************************************************
+int HardyZToFile(const char *FileName, mpfr_t t, mpfr_t Incr, uint64_t Count,
+	int Format, int CallerID, pHardyZRangeCallback pCallbackRange)
+{
+struct hgtSink		sink;
+int					Result = 1;
+size_t				ValueSize;
+
+if(Format != HGT_FILE_DOUBLE && Format != HGT_FILE_MPFR) {
+	return(0);
+	}
+ValueSize = sizeof(struct fileValue) + mpfr_custom_get_size(hgt_init.DefaultBits);
+ValueSize = (ValueSize + 7) & ~((size_t) 7);
+
+memset(&sink, 0, sizeof(sink));
+memcpy(sink.Header.Magic, FILE_MAGIC, 8);
+sink.Header.Version		= FILE_VERSION;
+sink.Header.Format		= (uint32_t) Format;
+sink.Header.Bits		= (uint32_t) hgt_init.DefaultBits;
+sink.Header.LimbBytes	= (uint32_t) sizeof(mp_limb_t);
+sink.Header.ValueSize	= ValueSize;
+sink.Header.RecordSize	= Format == HGT_FILE_MPFR ? 2 * ValueSize : 2 * sizeof(double);
+sink.Header.HeaderSize	= (HGT_FILE_FIXED + 3 * ValueSize + 63) & ~((uint64_t) 63);
+sink.Header.Count		= Count;
+sink.Header.IndexStride	= HGT_FILE_INDEX_STRIDE;
+sink.pCallbackRange	= pCallbackRange;
+mpfr_inits2 (hgt_init.DefaultBits, sink.Start, sink.Incr, sink.Next, (mpfr_ptr) 0);
+mpfr_set (sink.Start, t, MPFR_RNDN);
+mpfr_set (sink.Incr, Incr, MPFR_RNDN);
+mpfr_set (sink.Next, t, MPFR_RNDN);
+
+// -------------------------------------------------------------------
+// Step 1.  Open the file.  A new (or empty) file gets a header with
+// nothing committed; an old one must hold the same run.
+// -------------------------------------------------------------------
+if((sink.File = fopen(FileName, "r+b")) == NULL) {
+	sink.File = fopen(FileName, "w+b");
+	}
+if(sink.File == NULL) {
+	mpfr_clears (sink.Start, sink.Incr, sink.Next, (mpfr_ptr) 0);
+	return(0);
+	}
+Result = FileReadHeader(&sink);
+if(Result == -1) {
+	Result = FileWriteHeader(&sink) && FileSync(sink.File);
+	}
+sink.Record = malloc(sink.Header.RecordSize);
+
+// -------------------------------------------------------------------
+// Step 2.  Compute the rest of the points.
+// -------------------------------------------------------------------
+if(Result == 1 && sink.Header.IndexOffset == 0) {
+	fseeko(sink.File, (off_t) (sink.Header.HeaderSize
+		+ sink.Header.Committed * sink.Header.RecordSize), SEEK_SET);
+	sink.Base  = sink.Header.Committed;
+	activeSink = &sink;
+	HardyZWithRange(sink.Next, Incr, Count - sink.Header.Committed, CallerID, FileCallback);
+	activeSink = NULL;
+
+	// ---------------------------------------------------------------
+	// Step 3.  Commit the last records, and add the index.
+	// ---------------------------------------------------------------
+	Result = sink.Error == 0 && FileCheckpoint(&sink, Count) && FileWriteIndex(&sink);
+	}
+
+fclose(sink.File);
+free(sink.Record);
+mpfr_clears (sink.Start, sink.Incr, sink.Next, (mpfr_ptr) 0);
+return(Result);
+}
+
+// *******************************************************************
+// Point t and Z at record Index of a memory-mapped HGT_FILE_MPFR file
+// (Map is the start of the file; no copy is made).  As with
+// TableViewMPFR, t and Z must not be initialized, cleared or written
+// to.  Returns 0 if the file is not an MPFR result file or Index is
+// past the last committed record.
+// *******************************************************************
+int HardyZFileView(const void *Map, uint64_t Index, mpfr_t t, mpfr_t Z)
+{
+struct HGT_FILE_HEADER	Header;
+struct fileValue		Value;
+const unsigned char		*Rec;
+
+memcpy(&Header, Map, sizeof(Header));
+if(memcmp(Header.Magic, FILE_MAGIC, 8) != 0 || Header.Format != HGT_FILE_MPFR
+		|| Index >= Header.Committed) {
+	return(0);
+	}
+Rec = (const unsigned char *) Map + Header.HeaderSize + Index * Header.RecordSize;
+memcpy(&Value, Rec, sizeof(Value));
+mpfr_custom_init_set(t, (int) Value.Kind, (mpfr_exp_t) Value.Exp, Header.Bits,
+	(void *) (Rec + sizeof(Value)));
+Rec += Header.ValueSize;
+memcpy(&Value, Rec, sizeof(Value));
+mpfr_custom_init_set(Z, (int) Value.Kind, (mpfr_exp_t) Value.Exp, Header.Bits,
+	(void *) (Rec + sizeof(Value)));
+return(1);
+}
+
+// -------------------------------------------------------------------
+// The HardyZWithRange callback: write one record, pass the point on,
+// and commit every HGT_FILE_CHECKPOINT records.
+// -------------------------------------------------------------------
+static int FileCallback(mpfr_t t, mpfr_t z, uint64_t i, int CallerID)
+{
+struct hgtSink		*sink = activeSink;
+uint64_t			Index = sink->Base + i;
+double				dd[2];
+
+if(sink->Header.Format == HGT_FILE_MPFR) {
+	FilePutMPFR(sink->Record, sink->Header.ValueSize, sink->Header.Bits, t);
+	FilePutMPFR(sink->Record + sink->Header.ValueSize, sink->Header.ValueSize,
+		sink->Header.Bits, z);
+	}
+else {
+	dd[0] = mpfr_get_d (t, MPFR_RNDN);
+	dd[1] = mpfr_get_d (z, MPFR_RNDN);
+	memcpy(sink->Record, dd, sizeof(dd));
+	}
+if(fwrite(sink->Record, sink->Header.RecordSize, 1, sink->File) != 1) {
+	sink->Error = 1;
+	}
+if(sink->pCallbackRange != NULL) {
+	sink->pCallbackRange(t, z, Index, CallerID);
+	}
+
+mpfr_add (sink->Next, t, sink->Incr, MPFR_RNDN);
+if((Index + 1) % HGT_FILE_CHECKPOINT == 0 && sink->Error == 0) {
+	sink->Error = FileCheckpoint(sink, Index + 1) == 0;
+	}
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Flush the records to disk, then record that the first Committed
+// of them are good (and the t to go on from), and flush that too.
+// -------------------------------------------------------------------
+static int FileCheckpoint(struct hgtSink *sink, uint64_t Committed)
+{
+if(FileSync(sink->File) == 0) {
+	return(0);
+	}
+sink->Header.Committed = Committed;
+if(FileWriteHeader(sink) == 0 || FileSync(sink->File) == 0) {
+	return(0);
+	}
+return(fseeko(sink->File, (off_t) (sink->Header.HeaderSize
+	+ Committed * sink->Header.RecordSize), SEEK_SET) == 0);
+}
+
+// -------------------------------------------------------------------
+// Write the header (with the start t, Incr and next t) at the start
+// of the file.
+// -------------------------------------------------------------------
+static int FileWriteHeader(struct hgtSink *sink)
+{
+unsigned char	*Buffer;
+size_t			Size = sink->Header.HeaderSize;
+int				Result;
+
+Buffer = calloc(1, Size);
+memcpy(Buffer, &sink->Header, sizeof(sink->Header));
+FilePutMPFR(Buffer + HGT_FILE_FIXED, sink->Header.ValueSize, sink->Header.Bits,
+	sink->Start);
+FilePutMPFR(Buffer + HGT_FILE_FIXED + sink->Header.ValueSize, sink->Header.ValueSize,
+	sink->Header.Bits, sink->Incr);
+FilePutMPFR(Buffer + HGT_FILE_FIXED + 2 * sink->Header.ValueSize,
+	sink->Header.ValueSize, sink->Header.Bits, sink->Next);
+rewind(sink->File);
+Result = fwrite(Buffer, Size, 1, sink->File) == 1;
+free(Buffer);
+return(Result);
+}
+
+// -------------------------------------------------------------------
+// Read the header of an existing file into sink.  Returns -1 for an
+// empty file, 0 if the file holds some other run, and 1 if it holds
+// (part of) this one; then sink->Header and sink->Next are set from
+// the file.
+// -------------------------------------------------------------------
+static int FileReadHeader(struct hgtSink *sink)
+{
+struct HGT_FILE_HEADER	Header;
+unsigned char			*Buffer;
+mpfr_t					Start, Incr;
+int						Result;
+
+rewind(sink->File);
+if(fread(&Header, sizeof(Header), 1, sink->File) != 1) {
+	return(-1);
+	}
+if(memcmp(Header.Magic, FILE_MAGIC, 8) != 0
+		|| Header.Version	 != sink->Header.Version
+		|| Header.Format	 != sink->Header.Format
+		|| Header.Bits		 != sink->Header.Bits
+		|| Header.LimbBytes	 != sink->Header.LimbBytes
+		|| Header.ValueSize	 != sink->Header.ValueSize
+		|| Header.HeaderSize != sink->Header.HeaderSize
+		|| Header.Count		 != sink->Header.Count) {
+	return(0);
+	}
+
+Buffer = malloc(Header.HeaderSize);
+rewind(sink->File);
+if(fread(Buffer, Header.HeaderSize, 1, sink->File) != 1) {
+	free(Buffer);
+	return(0);
+	}
+mpfr_inits2 (Header.Bits, Start, Incr, (mpfr_ptr) 0);
+FileGetMPFR(Start, Buffer + HGT_FILE_FIXED, Header.Bits);
+FileGetMPFR(Incr, Buffer + HGT_FILE_FIXED + Header.ValueSize, Header.Bits);
+Result = mpfr_equal_p (Start, sink->Start) && mpfr_equal_p (Incr, sink->Incr);
+if(Result == 1) {
+	FileGetMPFR(sink->Next, Buffer + HGT_FILE_FIXED + 2 * Header.ValueSize, Header.Bits);
+	sink->Header = Header;
+	}
+mpfr_clears (Start, Incr, (mpfr_ptr) 0);
+free(Buffer);
+return(Result);
+}
+
+// -------------------------------------------------------------------
+// Write the index after the last record, note it in the header, and
+// cut off anything left past it.
+// -------------------------------------------------------------------
+static int FileWriteIndex(struct hgtSink *sink)
+{
+struct HGT_FILE_HEADER	*Header = &sink->Header;
+mpfr_t					t;
+double					*Index;
+double					dd[2];
+uint64_t				i;
+int						Result = 1;
+
+Header->IndexEntries = (Header->Count + Header->IndexStride - 1) / Header->IndexStride;
+Header->IndexOffset	 = Header->HeaderSize + Header->Count * Header->RecordSize;
+Index = malloc((Header->IndexEntries + 1) * sizeof(double));
+mpfr_init2 (t, Header->Bits);
+
+// -------------------------------------------------------------------
+// Read back the t of every IndexStride-th record.
+// -------------------------------------------------------------------
+for(i = 0; i < Header->IndexEntries && Result == 1; i++) {
+	fseeko(sink->File, (off_t) (Header->HeaderSize
+		+ i * Header->IndexStride * Header->RecordSize), SEEK_SET);
+	if(fread(sink->Record, Header->RecordSize, 1, sink->File) != 1) {
+		Result = 0;
+		}
+	else if(Header->Format == HGT_FILE_MPFR) {
+		FileGetMPFR(t, sink->Record, Header->Bits);
+		Index[i] = mpfr_get_d (t, MPFR_RNDN);
+		}
+	else {
+		memcpy(dd, sink->Record, sizeof(dd));
+		Index[i] = dd[0];
+		}
+	}
+if(Result == 1) {
+	fseeko(sink->File, (off_t) Header->IndexOffset, SEEK_SET);
+	Result = fwrite(Index, sizeof(double), Header->IndexEntries, sink->File)
+			 == Header->IndexEntries;
+	}
+free(Index);
+mpfr_clear (t);
+if(Result == 0 || FileSync(sink->File) == 0) {
+	return(0);
+	}
+
+Result = FileWriteHeader(sink) && FileSync(sink->File);
+#ifndef _WIN32
+if(Result == 1) {
+	Result = ftruncate(fileno(sink->File), (off_t) (Header->IndexOffset
+		+ Header->IndexEntries * sizeof(double))) == 0;
+	}
+#endif
+return(Result);
+}
+
+// -------------------------------------------------------------------
+// Flush File all the way to disk.
+// -------------------------------------------------------------------
+static int FileSync(FILE *File)
+{
+if(fflush(File) != 0) {
+	return(0);
+	}
+#ifndef _WIN32
+return(fsync(fileno(File)) == 0);
+#else
+return(_commit(_fileno(File)) == 0);
+#endif
+}
+
+// -------------------------------------------------------------------
+// Store one MPFR value (at Dest), and read one back.
+// -------------------------------------------------------------------
+static void FilePutMPFR(unsigned char *Dest, size_t ValueSize, int Bits, mpfr_t x)
+{
+struct fileValue	Value;
+
+memset(Dest, 0, ValueSize);
+Value.Kind = mpfr_custom_get_kind(x);			// negative for x < 0
+Value.Exp  = mpfr_regular_p (x) ? mpfr_custom_get_exp(x) : 0;
+memcpy(Dest, &Value, sizeof(Value));
+if(mpfr_regular_p (x)) {
+	memcpy(Dest + sizeof(Value), mpfr_custom_get_significand(x),
+		mpfr_custom_get_size(Bits));
+	}
+}
+
+static void FileGetMPFR(mpfr_t x, const unsigned char *Src, int Bits)
+{
+struct fileValue	Value;
+mpfr_t				View;
+
+memcpy(&Value, Src, sizeof(Value));
+mpfr_custom_init_set(View, (int) Value.Kind, (mpfr_exp_t) Value.Exp, Bits,
+	(void *) (Src + sizeof(Value)));
+mpfr_set (x, View, MPFR_RNDN);
+}
@@ -0,0 +1,485 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <gmp.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file holds the fixed-point backend for the main sum:
+//
+//		Sum = SUM_{n = nFirst}^{nLast}  n^{-1/2} cos(theta - t log n)
+//
+// at 2, 3 or 4 limbs (up to 128, 192 or 256 bits).  Every quantity in
+// the loop is a nonnegative fraction held in a fixed number of limbs
+// and worked on with the GMP mpn_ functions, so there is no exponent
+// handling, rounding or allocation per operation.  The kernel is
+// written once, as FixedSumCore, and compiled (always inlined) for
+// each limb count L, which fixes every array size and mpn_ length at
+// compile time.  MainSumFixed is called by RS_MainTermRange when the
+// context allows it (see SetFixedPoint).
+//
+// With W = L + 1 limbs (one guard limb) and G = L + 2 limbs for the
+// phase, the kernel computes, for each n:
+//
+//	 (1) the phase in turns, x = frac(theta / 2 pi - tau log n), where
+//		 tau = t / 2 pi.  tau and log n each have an integer part (one
+//		 limb) and a G-limb fraction, and only the fraction of the
+//		 product is kept;
+//	 (2) log(n + 1) from log n, by adding 2 atanh(1 / (2n + 1)), summed
+//		 by Horner's rule in 1 / (2n + 1)^2 with mpn_divrem_1;
+//	 (3) n^{-1/2} as the square root of 2^{128 W} / n (mpn_sqrtrem);
+//	 (4) cos(2 pi x): x is reduced to an octant y in [0, 1/8), and y
+//		 is split as j0 / 2^11 + j1 / 2^19 + j2 / 2^27 + r.  The first
+//		 three parts come from tables and r from a Taylor series (r is
+//		 below 2^-27 turns, so the series is short).  Each angle is
+//		 kept as the pair C = 1 - cos, S = sin, which are nonnegative
+//		 and below 1 in the first octant, and the pairs are combined
+//		 with the addition formulas;
+//	 (5) the term, added to a positive or a negative total.
+//
+// Each step truncates at the last limb, so the error per term is a
+// few units of 2^{-64 W}, 64 bits below the precision asked for.  The
+// error in log n grows with the number of steps, but the runs are at
+// most HGT_MAIN_SPLIT_MIN terms (larger sums are split into blocks of
+// HGT_MAIN_BLOCK terms), and G has a limb to spare for that.  The
+// values going in (tau, theta / 2 pi and the first log n) and the sum
+// coming out are converted with MPFR, once per call.  RS_MainTermBound
+// includes a bound on all of this.
+// -------------------------------------------------------------------
+
+#define		FIXED_W_MAX			(HGT_FIXED_LIMBS_MAX + 1)
+#define		FIXED_G_MAX			(HGT_FIXED_LIMBS_MAX + 2)
+#define		FIXED_TAB_LEVELS	3
+#define		FIXED_TAB_BITS		8
+#define		FIXED_TAB_SIZE		(1 << FIXED_TAB_BITS)
+#define		FIXED_ATANH_MAX		(32 * FIXED_G_MAX + 2)	// see FixedLogStep
+
+// -------------------------------------------------------------------
+// The tables are held at FIXED_W_MAX limbs; a kernel with W limbs
+// uses the top W of them (truncating the rest).  fixC and fixS hold
+// 1 - cos and sin of 2 pi j / 2^{11 + 8 Level}; fixTwoPi holds 2 pi - 6;
+// fixInvOdd holds 1 / (2k + 1) at FIXED_G_MAX limbs.  They are held
+// by every context with coefficients (fixUsers counts them, under 
+// fixLock): built when the first one is set up and freed when the 
+// last one is closed, so every thread of a live context may read them.
+// -------------------------------------------------------------------
+static mp_limb_t	fixC[FIXED_TAB_LEVELS][FIXED_TAB_SIZE][FIXED_W_MAX];
+static mp_limb_t	fixS[FIXED_TAB_LEVELS][FIXED_TAB_SIZE][FIXED_W_MAX];
+static mp_limb_t	fixTwoPi[FIXED_W_MAX];
+static mp_limb_t	fixInvOdd[FIXED_ATANH_MAX][FIXED_G_MAX];
+static mpfr_t		fixTwoPiMPFR;					// 2 pi, for the conversions
+static atomic_bool	fixReady = false;
+static pthread_mutex_t	fixLock = PTHREAD_MUTEX_INITIALIZER;
+static int			fixUsers = 0;					// contexts holding the tables
+
+static int	FixedFromMPFR(mp_limb_t *r, int Limbs, mpfr_t x);
+
+// -------------------------------------------------------------------
+// r = the top W limbs of a * b (a and b W-limb fractions).
+// -------------------------------------------------------------------
+static inline void FixMul(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b, int W)
+{
+mp_limb_t	p[2 * FIXED_G_MAX];
+
+mpn_mul_n(p, a, b, W);
+memcpy(r, p + W, W * sizeof(mp_limb_t));
+}
+
+// -------------------------------------------------------------------
+// Add the angle (Cv, Sv) to the angle (C, S):
+//		C' = C + Cv - C Cv + S Sv
+//		S' = S + Sv - S Cv - C Sv
+// Both angles, and their sum, must lie in [0, pi / 4].
+// -------------------------------------------------------------------
+static inline void FixCompose(mp_limb_t *C, mp_limb_t *S, const mp_limb_t *Cv,
+	const mp_limb_t *Sv, int W)
+{
+mp_limb_t	CC[FIXED_W_MAX], SS[FIXED_W_MAX], SC[FIXED_W_MAX], CS[FIXED_W_MAX];
+
+FixMul(CC, C, Cv, W);
+FixMul(SS, S, Sv, W);
+FixMul(SC, S, Cv, W);
+FixMul(CS, C, Sv, W);
+mpn_add_n(C, C, Cv, W);
+mpn_add_n(C, C, SS, W);
+mpn_sub_n(C, C, CC, W);
+mpn_add_n(S, S, Sv, W);
+mpn_sub_n(S, S, SC, W);
+mpn_sub_n(S, S, CS, W);
+}
+
+// -------------------------------------------------------------------
+// C = 1 - cos(2 pi y) and S = sin(2 pi y), for y in [0, 1/8).
+// -------------------------------------------------------------------
+static inline void FixCosSin(mp_limb_t *C, mp_limb_t *S, mp_limb_t *y, int W)
+{
+mp_limb_t	Phi[FIXED_W_MAX], Term[FIXED_W_MAX], Neg[FIXED_W_MAX];
+mp_limb_t	CNeg[FIXED_W_MAX];
+mp_limb_t	Top = y[W - 1];
+int			j, Level;
+
+// ---------------------------------------------------------------
+// Phi = 2 pi r, where r is y less its leading 27 bits.
+// ---------------------------------------------------------------
+y[W - 1] &= ((mp_limb_t) 1 << (64 - 3 - FIXED_TAB_LEVELS * FIXED_TAB_BITS)) - 1;
+FixMul(Phi, y, fixTwoPi + FIXED_W_MAX - W, W);
+mpn_addmul_1(Phi, y, W, 6);
+
+// ---------------------------------------------------------------
+// The Taylor series: Phi^k / k! goes to S (k odd) or C (k even),
+// with the sign (-1)^{floor(k / 2)}; we stop when the term is zero.
+// ---------------------------------------------------------------
+memcpy(S, Phi, W * sizeof(mp_limb_t));
+memcpy(Term, Phi, W * sizeof(mp_limb_t));
+memset(C, 0, W * sizeof(mp_limb_t));
+memset(Neg, 0, W * sizeof(mp_limb_t));
+memset(CNeg, 0, W * sizeof(mp_limb_t));
+for(j = 2; ; j++) {
+	FixMul(Term, Term, Phi, W);
+	mpn_divrem_1(Term, 0, Term, W, (mp_limb_t) j);
+	if(mpn_zero_p(Term, W)) {
+		break;
+		}
+	switch(j % 4) {
+		case 0:	mpn_add_n(CNeg, CNeg, Term, W);	break;
+		case 1:	mpn_add_n(S, S, Term, W);		break;
+		case 2:	mpn_add_n(C, C, Term, W);		break;
+		case 3:	mpn_add_n(Neg, Neg, Term, W);	break;
+		}
+	}
+mpn_sub_n(C, C, CNeg, W);
+mpn_sub_n(S, S, Neg, W);
+
+// ---------------------------------------------------------------
+// Add the table angles, smallest first.
+// ---------------------------------------------------------------
+for(Level = FIXED_TAB_LEVELS - 1; Level >= 0; Level--) {
+	j = (int) (Top >> (64 - 3 - (Level + 1) * FIXED_TAB_BITS)) & (FIXED_TAB_SIZE - 1);
+	if(j != 0) {
+		FixCompose(C, S, fixC[Level][j] + FIXED_W_MAX - W,
+			fixS[Level][j] + FIXED_W_MAX - W, W);
+		}
+	}
+}
+
+// -------------------------------------------------------------------
+// Add log((n + 1) / n) = 2 atanh(z), z = 1 / d, d = 2n + 1, to the
+// G-limb fraction LogF (carrying into LogI).  With v = 1/3 + z^2 (1/5
+// + z^2 (1/7 + ...)), summed by Horner's rule from the K-th term
+// (z^{2K + 1} / (2K + 1) < 2^{-64 G}), the step is 2/d + 2 z^2 v / d.
+// -------------------------------------------------------------------
+static inline void FixedLogStep(mp_limb_t *LogF, uint64_t *LogI, uint64_t n, int G)
+{
+mp_limb_t	v[FIXED_G_MAX + 1], Step[FIXED_G_MAX + 1], Two = 2;
+mp_limb_t	d = (mp_limb_t) (2 * n + 1), d2;
+int			k, K, Bits = 63 - __builtin_clzll(d);
+
+K  = (64 * G / Bits + 1) / 2 + 1;
+K  = K < FIXED_ATANH_MAX ? K : FIXED_ATANH_MAX - 1;
+d2 = d < ((mp_limb_t) 1 << 32) ? d * d : 0;
+memcpy(v, fixInvOdd[K] + FIXED_G_MAX - G, G * sizeof(mp_limb_t));
+for(k = K - 1; k >= 0; k--) {
+	if(d2 != 0) {
+		mpn_divrem_1(v, 0, v, G, d2);
+		}
+	else {
+		mpn_divrem_1(v, 0, v, G, d);
+		mpn_divrem_1(v, 0, v, G, d);
+		}
+	if(k > 0) {
+		mpn_add_n(v, v, fixInvOdd[k] + FIXED_G_MAX - G, G);
+		}
+	}
+mpn_lshift(v, v, G, 1);
+mpn_divrem_1(v, 0, v, G, d);
+mpn_divrem_1(Step, G, &Two, 1, d);			// 2 / d (Step[G] is 0)
+mpn_add_n(v, v, Step, G);
+*LogI += mpn_add_n(LogF, LogF, v, G);
+}
+
+// -------------------------------------------------------------------
+// The kernel, for L limbs.  Sum gets the sum from nFirst to nLast as
+// a signed value; tau, Theta (theta / 2 pi) and the first log n come
+// in as described above.
+// -------------------------------------------------------------------
+static inline __attribute__ ((always_inline)) void FixedSumCore(mpfr_t Sum,
+	uint64_t TauI, const mp_limb_t *TauF, const mp_limb_t *Theta, uint64_t LogI,
+	mp_limb_t *LogF, uint64_t nFirst, uint64_t nLast, const int L)
+{
+const int	W = L + 1, G = L + 2;
+mp_limb_t	Phase[FIXED_G_MAX], Temp[2 * FIXED_G_MAX], x[FIXED_W_MAX];
+mp_limb_t	Root[2 * FIXED_W_MAX + 1], w[FIXED_W_MAX], C[FIXED_W_MAX];
+mp_limb_t	S[FIXED_W_MAX], Prod[FIXED_W_MAX], One = 1;
+mp_limb_t	Pos[FIXED_W_MAX + 1], Neg[FIXED_W_MAX + 1], *pTotal;
+mpz_t		z;
+uint64_t	n;
+int			Octant;
+
+memset(Pos, 0, (W + 1) * sizeof(mp_limb_t));
+memset(Neg, 0, (W + 1) * sizeof(mp_limb_t));
+for(n = nFirst; n <= nLast; n++) {
+	// ---------------------------------------------------------------
+	// (1) x = frac(Theta - frac(tau log n)), using the top W limbs of
+	// the G-limb phase.
+	// ---------------------------------------------------------------
+	mpn_mul_1(Phase, LogF, G, (mp_limb_t) TauI);
+	mpn_addmul_1(Phase, TauF, G, (mp_limb_t) LogI);
+	mpn_mul_n(Temp, TauF, LogF, G);
+	mpn_add_n(Phase, Phase, Temp + G, G);
+	mpn_sub_n(x, Theta, Phase + G - W, W);
+
+	// ---------------------------------------------------------------
+	// (2) log(n + 1), ready for the next n.
+	// ---------------------------------------------------------------
+	FixedLogStep(LogF, &LogI, n, G);
+
+	// ---------------------------------------------------------------
+	// (3) w = n^{-1/2} = sqrt(2^{128 W} / n) / 2^{64 W}.
+	// ---------------------------------------------------------------
+	mpn_divrem_1(Root, 2 * W, &One, 1, (mp_limb_t) n);
+	mpn_sqrtrem(w, NULL, Root, 2 * W);
+
+	// ---------------------------------------------------------------
+	// (4) Reduce x to y in [0, 1/8) (odd octants are reflected), and
+	// find C = 1 - cos(2 pi y), S = sin(2 pi y).  Then cos(2 pi x) is
+	// +- cos or +- sin of 2 pi y, as the octant says.
+	// ---------------------------------------------------------------
+	Octant = (int) (x[W - 1] >> 61);
+	if(Octant & 1) {
+		mpn_com(x, x, W);
+		}
+	x[W - 1] &= ((mp_limb_t) 1 << 61) - 1;
+	FixCosSin(C, S, x, W);
+
+	// ---------------------------------------------------------------
+	// (5) The term: w (1 - C) or w S, with its sign.
+	// ---------------------------------------------------------------
+	pTotal = ((Octant + 2) & 4) != 0 ? Neg : Pos;
+	if(((Octant + 1) & 2) != 0) {
+		FixMul(Prod, w, S, W);
+		mpn_add(pTotal, pTotal, W + 1, Prod, W);
+		}
+	else {
+		FixMul(Prod, w, C, W);
+		mpn_add(pTotal, pTotal, W + 1, w, W);
+		mpn_add(pTotal == Pos ? Neg : Pos, pTotal == Pos ? Neg : Pos, W + 1, Prod, W);
+		}
+	}
+
+// -------------------------------------------------------------------
+// Sum = (Pos - Neg) / 2^{64 W}.
+// -------------------------------------------------------------------
+mpz_init(z);
+if(mpn_cmp(Pos, Neg, W + 1) >= 0) {
+	mpn_sub_n(Pos, Pos, Neg, W + 1);
+	mpz_import(z, W + 1, -1, sizeof(mp_limb_t), 0, 0, Pos);
+	}
+else {
+	mpn_sub_n(Pos, Neg, Pos, W + 1);
+	mpz_import(z, W + 1, -1, sizeof(mp_limb_t), 0, 0, Pos);
+	mpz_neg(z, z);
+	}
+mpfr_set_z_2exp (Sum, z, -64 * W, MPFR_RNDN);
+mpz_clear(z);
+}
+
+static void FixedSum2(mpfr_t Sum, uint64_t TauI, const mp_limb_t *TauF,
+	const mp_limb_t *Theta, uint64_t LogI, mp_limb_t *LogF, uint64_t nFirst,
+	uint64_t nLast)
+{
+FixedSumCore(Sum, TauI, TauF, Theta, LogI, LogF, nFirst, nLast, 2);
+}
+
+static void FixedSum3(mpfr_t Sum, uint64_t TauI, const mp_limb_t *TauF,
+	const mp_limb_t *Theta, uint64_t LogI, mp_limb_t *LogF, uint64_t nFirst,
+	uint64_t nLast)
+{
+FixedSumCore(Sum, TauI, TauF, Theta, LogI, LogF, nFirst, nLast, 3);
+}
+
+static void FixedSum4(mpfr_t Sum, uint64_t TauI, const mp_limb_t *TauF,
+	const mp_limb_t *Theta, uint64_t LogI, mp_limb_t *LogF, uint64_t nFirst,
+	uint64_t nLast)
+{
+FixedSumCore(Sum, TauI, TauF, Theta, LogI, LogF, nFirst, nLast, 4);
+}
+
+// *******************************************************************
+// Can the main sum at Bits precision be done in fixed point by the
+// current context?  Only a context with coefficients holds the tables.
+// *******************************************************************
+bool FixedUsable(int Bits)
+{
+return(hgt_init.FixedPoint == true && Bits <= 64 * HGT_FIXED_LIMBS_MAX
+	&& hgt_current->HasCoeff == true && atomic_load_explicit(&fixReady, memory_order_acquire) == true);
+}
+
+// *******************************************************************
+// Turn the fixed-point backend on or off for the current context.  It
+// starts out on when DefaultBits is at most 64 * HGT_FIXED_LIMBS_MAX.
+// *******************************************************************
+int SetFixedPoint(bool On)
+{
+hgt_init.FixedPoint = On;
+return(1);
+}
+
+// *******************************************************************
+// Add SUM_{n = nFirst}^{nLast} n^{-1/2} cos(Theta - t log n) to Sum,
+// in fixed point with enough limbs for Bits.  Returns 0 (and does
+// nothing) if FixedUsable(Bits) is false or t is too large.
+// *******************************************************************
+int MainSumFixed(mpfr_t Sum, mpfr_t t, mpfr_t Theta, uint64_t nFirst,
+	uint64_t nLast, int Bits)
+{
+struct HGT_WORKMARK	Mark;
+mp_limb_t	TauF[FIXED_G_MAX], ThetaF[FIXED_W_MAX], LogF[FIXED_G_MAX];
+mpfr_t		Temp1, Part;
+uint64_t	TauI, LogI;
+int			L, Prec;
+
+if(FixedUsable(Bits) == false || nFirst < 2) {
+	return(0);
+	}
+if(nFirst > nLast) {
+	return(1);
+	}
+L	 = Bits <= 64 * HGT_FIXED_LIMBS_MIN ? HGT_FIXED_LIMBS_MIN : (Bits + 63) / 64;
+Prec = 64 * (L + 4);
+
+// -------------------------------------------------------------------
+// tau = t / 2 pi, frac(theta / 2 pi) and log(nFirst), each as an
+// integer part and a fraction.
+// -------------------------------------------------------------------
+Mark = WorkMark();
+WorkInits(Prec, Temp1, Part, (mpfr_ptr) 0);
+mpfr_div (Temp1, t, fixTwoPiMPFR, MPFR_RNDN);
+if(mpfr_cmp_d (Temp1, 1.8e19) >= 0) {
+	WorkRelease(Mark);
+	return(0);
+	}
+mpfr_modf (Temp1, Part, Temp1, MPFR_RNDN);
+TauI = mpfr_get_uj (Temp1, MPFR_RNDN);
+FixedFromMPFR(TauF, L + 2, Part);
+
+mpfr_div (Temp1, Theta, fixTwoPiMPFR, MPFR_RNDN);
+mpfr_frac (Temp1, Temp1, MPFR_RNDN);
+if(mpfr_sgn (Temp1) < 0) {
+	mpfr_add_ui (Temp1, Temp1, 1, MPFR_RNDN);
+	}
+FixedFromMPFR(ThetaF, L + 1, Temp1);
+
+mpfr_set_uj (Temp1, nFirst, MPFR_RNDN);
+mpfr_log (Temp1, Temp1, MPFR_RNDN);
+mpfr_modf (Temp1, Part, Temp1, MPFR_RNDN);
+LogI = mpfr_get_uj (Temp1, MPFR_RNDN);
+FixedFromMPFR(LogF, L + 2, Part);
+
+// -------------------------------------------------------------------
+// Run the kernel for L limbs, and add its result to Sum.
+// -------------------------------------------------------------------
+switch(L) {
+	case 2:		FixedSum2(Temp1, TauI, TauF, ThetaF, LogI, LogF, nFirst, nLast);	break;
+	case 3:		FixedSum3(Temp1, TauI, TauF, ThetaF, LogI, LogF, nFirst, nLast);	break;
+	default:	FixedSum4(Temp1, TauI, TauF, ThetaF, LogI, LogF, nFirst, nLast);	break;
+	}
+mpfr_add (Sum, Sum, Temp1, MPFR_RNDN);
+WorkRelease(Mark);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Take a hold on the tables for a context, building them if no other
+// context holds them.  This is called by InitCoeffMPFR.
+// -------------------------------------------------------------------
+int BuildFixedTables(void)
+{
+mpfr_t		Angle, Sin, Cos, TwoPi;
+mp_limb_t	One = 1;
+int			Level, j, k;
+
+pthread_mutex_lock(&fixLock);
+if(fixUsers++ > 0) {
+	pthread_mutex_unlock(&fixLock);
+	return(1);
+	}
+mpfr_inits2 (64 * (FIXED_G_MAX + 2), Angle, Sin, Cos, TwoPi, (mpfr_ptr) 0);
+mpfr_const_pi (TwoPi, MPFR_RNDN);
+mpfr_mul_2ui (TwoPi, TwoPi, 1, MPFR_RNDN);
+for(Level = 0; Level < FIXED_TAB_LEVELS; Level++) {
+	for(j = 0; j < FIXED_TAB_SIZE; j++) {
+		mpfr_mul_ui (Angle, TwoPi, (unsigned long int) j, MPFR_RNDN);
+		mpfr_div_2ui (Angle, Angle, 3 + (Level + 1) * FIXED_TAB_BITS, MPFR_RNDN);
+		mpfr_sin_cos (Sin, Cos, Angle, MPFR_RNDN);
+		mpfr_ui_sub (Cos, 1, Cos, MPFR_RNDN);
+		FixedFromMPFR(fixC[Level][j], FIXED_W_MAX, Cos);
+		FixedFromMPFR(fixS[Level][j], FIXED_W_MAX, Sin);
+		}
+	}
+mpfr_sub_ui (Angle, TwoPi, 6, MPFR_RNDN);
+FixedFromMPFR(fixTwoPi, FIXED_W_MAX, Angle);
+mpfr_init2 (fixTwoPiMPFR, 64 * (FIXED_G_MAX + 2));
+mpfr_set (fixTwoPiMPFR, TwoPi, MPFR_RNDN);
+mpfr_clears (Angle, Sin, Cos, TwoPi, (mpfr_ptr) 0);
+
+for(k = 1; k < FIXED_ATANH_MAX; k++) {
+	mp_limb_t	q[FIXED_G_MAX + 1];
+
+	mpn_divrem_1(q, FIXED_G_MAX, &One, 1, (mp_limb_t) (2 * k + 1));
+	memcpy(fixInvOdd[k], q, FIXED_G_MAX * sizeof(mp_limb_t));
+	}
+atomic_store_explicit(&fixReady, true, memory_order_release);
+pthread_mutex_unlock(&fixLock);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Give up a context's hold on the tables (see CloseCoeffMPFR).  When
+// the last hold goes, we clear the one MPFR value the tables hold; a
+// later InitCoeffMPFR builds them again.
+// -------------------------------------------------------------------
+int FreeFixedTables(void)
+{
+pthread_mutex_lock(&fixLock);
+if(fixUsers > 0 && --fixUsers == 0) {
+	atomic_store_explicit(&fixReady, false, memory_order_relaxed);
+	mpfr_clear (fixTwoPiMPFR);
+	}
+pthread_mutex_unlock(&fixLock);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// r = the Limbs-limb fraction x * 2^{64 Limbs} (truncated), for
+// x in [0, 1).
+// -------------------------------------------------------------------
+static int FixedFromMPFR(mp_limb_t *r, int Limbs, mpfr_t x)
+{
+mpfr_t		Scaled;
+mpz_t		z;
+size_t		Count = 0;
+
+mpfr_init2 (Scaled, mpfr_get_prec (x));
+mpz_init(z);
+mpfr_mul_2ui (Scaled, x, 64 * Limbs, MPFR_RNDN);
+mpfr_get_z (z, Scaled, MPFR_RNDZ);
+memset(r, 0, Limbs * sizeof(mp_limb_t));
+if(mpz_sgn(z) > 0 && mpz_sizeinbase(z, 2) <= (size_t) (64 * Limbs)) {
+	mpz_export(r, &Count, -1, sizeof(mp_limb_t), 0, 0, z);
+	}
+mpz_clear(z);
+mpfr_clear (Scaled);
+return(1);
+}
@@ -1,5 +1,5 @@
 // -------------------------------------------------------------------
-// Program last modified January 9, 2026. 
+// Program last modified October 16, 2026. 
 // Copyright (c) 2025-2026 Terrence P. Murphy
 // MIT License -- see hgt.h for details.
 // -------------------------------------------------------------------
@@ -11,62 +11,194 @@
 #include <string.h>
 #include <stdbool.h>
 #include <ctype.h>
+#include <pthread.h>
 #include <mpfr.h>
 
 #include "hgt.h"
 
-struct	HGT_INIT	hgt_init;
+// -------------------------------------------------------------------
+// The default context (set up by InitMPFR), and the context each 
+// thread is using.  Every thread starts out using the default one.
+// -------------------------------------------------------------------
+static struct HGT_CONTEXT					hgt_default;
+_Thread_local struct HGT_CONTEXT			*hgt_current = &hgt_default;
 
 // -------------------------------------------------------------------
-// We call this function before using any MPFR functions.  We set the
-// default MPFR precision and create global variables holding the
-// values of Pi 2Pi and Log(2), 
+// The number of contexts set up and not yet closed.  The log(n) / 
+// 1/sqrt(n) tables (see hgtTable.c) are shared by all of them, and are
+// closed with the last one.
+// -------------------------------------------------------------------
+static pthread_mutex_t						contextLock = PTHREAD_MUTEX_INITIALIZER;
+static int									contextCount = 0;
+
+static int	ContextInit(struct HGT_CONTEXT *Context, int DefaultBits, 
+				int MaxThreads, int DebugFlags, bool CalcHardy);
+static int	ContextClose(struct HGT_CONTEXT *Context);
+
+// -------------------------------------------------------------------
+// We call this function before using any MPFR functions.  We set up
+// the default context: we set the default MPFR precision and create 
+// variables holding the values of Pi 2Pi and Log(2), and we start the 
+// worker pool used by the multi-threaded library functions.
 // -------------------------------------------------------------------
 int InitMPFR(int DefaultBits, int MaxThreads, int DebugFlags, bool CalcHardy)
 {
-hgt_init.DefaultBits 	= DefaultBits;
-hgt_init.MaxThreads		= MaxThreads;
-hgt_init.DebugFlags		= DebugFlags;
+ContextInit(&hgt_default, DefaultBits, MaxThreads, DebugFlags, CalcHardy);
 
 // -------------------------------------------------------------------
 // Set default precision for MPFR
 // -------------------------------------------------------------------
-mpfr_set_default_prec (hgt_init.DefaultBits);
+mpfr_set_default_prec (DefaultBits);
+return(1);
+}
 
 // -------------------------------------------------------------------
-// Initialize the global mpfr (constant) variables
+// We call this function after we are done using all MPFR functions.  
+// We clear the default context, and the remaining memory and any 
+// cache used by MPFR. 
 // -------------------------------------------------------------------
-mpfr_inits2 (hgt_init.DefaultBits, hgt_init.myPi, hgt_init.my2Pi, 
-	hgt_init.myLog2, (mpfr_ptr) 0);
+int CloseMPFR(void)
+{
+ContextClose(&hgt_default);
+FreeCoefficientCache();				// see RSbuildcoeff.c
 
 // -------------------------------------------------------------------
-// Set the value of the global mpfr (constant) variables
+// Finish any timeline trace (see hgtStats.c).
 // -------------------------------------------------------------------
-mpfr_const_pi (hgt_init.myPi, MPFR_RNDN); 
-mpfr_mul_2ui (hgt_init.my2Pi, hgt_init.myPi, 1, MPFR_RNDN); /* 2Pi */
-mpfr_const_log2 (hgt_init.myLog2, MPFR_RNDN);
-if(CalcHardy == true){
-	InitCoeffMPFR(DefaultBits);
+StatsTraceClose();
+
+// -------------------------------------------------------------------
+// Clear this thread's workspace (see hgtWork.c) and the cache used
+// by MPFR.
+// -------------------------------------------------------------------
+WorkFree();
+mpfr_free_cache ();
+return(1);
+}
+
+// *******************************************************************
+// Create a context of its own, with the same arguments as InitMPFR.
+// Several contexts (say one at 128 bits and one at 512 bits, each 
+// with its own threads) can be in use at the same time; a thread 
+// works with one of them after a call to HgtContextUse.  A context 
+// may be created and freed while other contexts are busy.  Returns 
+// NULL if we are out of memory.
+// *******************************************************************
+struct HGT_CONTEXT * HgtContextCreate(int DefaultBits, int MaxThreads, 
+	int DebugFlags, bool CalcHardy)
+{
+struct HGT_CONTEXT	*Context = calloc(1, sizeof(struct HGT_CONTEXT));
+
+if(Context != NULL) {
+	ContextInit(Context, DefaultBits, MaxThreads, DebugFlags, CalcHardy);
 	}
+return(Context);
+}
+
+// *******************************************************************
+// Free a context made by HgtContextCreate.  No work may be in 
+// progress with it, and no thread may go on using it.
+// *******************************************************************
+int HgtContextFree(struct HGT_CONTEXT *Context)
+{
+if(Context == NULL || Context == &hgt_default) {
+	return(0);
+	}
+ContextClose(Context);
+free(Context);
 return(1);
 }
 
+// *******************************************************************
+// Make Context the calling thread's current context (NULL for the 
+// default one), and set the thread's default MPFR precision to match.
+// Every library function the thread calls afterwards -- including the
+// tasks they hand to the worker pool -- uses this context.  Returns
+// the context that was current, so that it can be restored.
+// *******************************************************************
+struct HGT_CONTEXT * HgtContextUse(struct HGT_CONTEXT *Context)
+{
+struct HGT_CONTEXT	*Previous = hgt_current;
+
+hgt_current = Context != NULL ? Context : &hgt_default;
+if(hgt_current->Init.DefaultBits > 0) {
+	mpfr_set_default_prec (hgt_current->Init.DefaultBits);
+	}
+return(Previous);
+}
+
 // -------------------------------------------------------------------
-// We call this function after we are done using all MPFR functions.  
-// We clear the remaining memory and any cache used by MPFR. 
+// Set up a context: its precision, its constants, (if CalcHardy) its
+// Gabcke coefficients, and its worker pool.
 // -------------------------------------------------------------------
-int CloseMPFR(void)
+static int ContextInit(struct HGT_CONTEXT *Context, int DefaultBits, 
+	int MaxThreads, int DebugFlags, bool CalcHardy)
 {
+struct HGT_INIT		*Init = &Context->Init;
+
+Init->DefaultBits 		= DefaultBits;
+Init->MaxThreads		= MaxThreads > 0 ? MaxThreads : HardwareThreads();
+Init->DebugFlags		= DebugFlags;
+Init->AccuracyDigits	= 0;			// see SetAccuracyDigits
+Init->FixedPoint		= DefaultBits <= 64 * HGT_FIXED_LIMBS_MAX;	// see hgtFixed.c
+
 // -------------------------------------------------------------------
-// Free the space used by the global mpfr (constant) variables
+// Instrumentation (see hgtStats.c) is off unless asked for.  A trace
+// goes to HGT_TRACE_FILE unless the caller has opened one already.
 // -------------------------------------------------------------------
-mpfr_clears (hgt_init.myPi, hgt_init.my2Pi, 
-			hgt_init.myLog2, (mpfr_ptr) 0);
+Init->Instrument = 0;
+if(DebugMode(DebugFlags, HGT_DEBUG_STATS) == true) {
+	Init->Instrument |= HGT_INSTRUMENT_STATS;
+	}
+if(DebugMode(DebugFlags, HGT_DEBUG_TRACE) == true) {
+	Init->Instrument |= HGT_INSTRUMENT_STATS | HGT_INSTRUMENT_TRACE;
+	StatsTraceOpen(HGT_TRACE_FILE);
+	}
 
 // -------------------------------------------------------------------
-// Clear the cache used by MPFR.
+// Initialize and set the context's mpfr (constant) variables
 // -------------------------------------------------------------------
-mpfr_free_cache ();
+mpfr_inits2 (DefaultBits, Init->myPi, Init->my2Pi, Init->myLog2, 
+	(mpfr_ptr) 0);
+mpfr_const_pi (Init->myPi, MPFR_RNDN); 
+mpfr_mul_2ui (Init->my2Pi, Init->myPi, 1, MPFR_RNDN); /* 2Pi */
+mpfr_const_log2 (Init->myLog2, MPFR_RNDN);
+Context->HasCoeff = false;
+if(CalcHardy == true){
+	InitCoeffMPFR(Context);
+	}
+
+// -------------------------------------------------------------------
+// Start the worker pool (no threads are created if MaxThreads is 1).
+// -------------------------------------------------------------------
+Context->Pool = PoolCreate(Context, Init->MaxThreads);
+Context->Jobs = JobsCreate();			// see hgtJob.c
+pthread_mutex_lock(&contextLock);
+contextCount++;
+pthread_mutex_unlock(&contextLock);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Wait for the context's jobs, stop its worker pool (each worker frees
+// its own MPFR cache) and free its coefficients and constants.  If it
+// is the last context, close any log(n) / 1/sqrt(n) tables.
+// -------------------------------------------------------------------
+static int ContextClose(struct HGT_CONTEXT *Context)
+{
+JobsFree(Context->Jobs);
+Context->Jobs = NULL;
+PoolDestroy(Context->Pool);
+Context->Pool = NULL;
+CloseCoeffMPFR(Context);
+mpfr_clears (Context->Init.myPi, Context->Init.my2Pi, 
+			Context->Init.myLog2, (mpfr_ptr) 0);
+pthread_mutex_lock(&contextLock);
+if(contextCount > 0 && --contextCount == 0) {
+	TableClose(HGT_BACKEND_MPFR);
+	TableClose(HGT_BACKEND_DD);
+	}
+pthread_mutex_unlock(&contextLock);
 return(1);
 }
 
@@ -93,14 +225,15 @@ return(GetLargeNumber(str, HGT_T_INCR_MIN, HGT_T_INCR_MAX, false));
 // -------------------------------------------------------------------
 // Validate the text string with a positive integer count value.
 // -------------------------------------------------------------------
-int ValidateCount(const char *str)
+int64_t ValidateCount(const char *str)
 {
-return(GetSmallPositiveInteger(str, HGT_COUNT_MIN, HGT_COUNT_MAX));
+return(GetLargePositiveInteger(str, HGT_COUNT_MIN, HGT_COUNT_MAX));
 }
 
 
 // -------------------------------------------------------------------
-// Validate the text string with a positive integer number of threads.
+// Validate the text string with the number of threads (0 for one per
+// CPU).
 // -------------------------------------------------------------------
 int ValidateThreads(const char *str)
 {
@@ -113,7 +246,7 @@ return(GetSmallPositiveInteger(str, HGT_THREADS_MIN, HGT_THREADS_MAX));
 // -------------------------------------------------------------------
 int ValidateDebugFlags(const char *str)
 {
-return(GetSmallPositiveInteger(str, HGT_DEBUG_MIN, HGT_DEBUG_MAX));
+return((int) GetLargePositiveInteger(str, HGT_DEBUG_MIN, HGT_DEBUG_MAX));
 }
 
 
@@ -269,3 +402,28 @@ if(Value < Min || Value > Max){
 	}
 return(Value);
 }
+
+// -------------------------------------------------------------------
+// As GetSmallPositiveInteger, but for a positive integer of up to 18
+// digits.  If validated, we return the integer value; otherwise we 
+// return -1.
+// -------------------------------------------------------------------
+int64_t GetLargePositiveInteger(const char *str, int64_t Min, int64_t Max)
+{
+char * 		ptr;
+size_t		Len;
+int64_t		Value;
+const char  sNum[] = "0123456789"; 
+
+Len = strlen(str);
+
+if(Len < 1 || Len > 18 || strspn(str, sNum) != Len){
+	return(-1); 
+	}
+
+Value = (int64_t) strtoll(str, &ptr, 10);
+if(Value < Min || Value > Max){
+	return(-1); 
+	}
+return(Value);
+}
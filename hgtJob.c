@@ -0,0 +1,610 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file holds the asynchronous job interface.  JobHardyZ,
+// JobGramAtN and JobGramRange queue a computation and return a handle
+// at once; the computation runs on the worker pool of the caller's
+// current context.  The caller then polls the handle (JobReady), waits
+// for it (JobWait), or has it posted to a completion queue (see
+// JobQueueCreate) and takes finished jobs from there (JobQueueNext).
+// JobValue gives the results, and JobFree gives the handle back.
+//
+// Each job has a priority: HGT_JOB_URGENT, HGT_JOB_NORMAL or
+// HGT_JOB_BULK.  A context keeps its queued jobs in one first-in
+// first-out list per priority, and every job submitted puts one runner
+// task on the pool.  A runner does not run the job it was submitted
+// for, but the most urgent job queued when it starts.  So a single
+// point submitted as HGT_JOB_URGENT is the next job started, ahead of
+// bulk sweeps queued before it; idle workers take runners before they
+// steal the pieces of jobs already running (see PoolTakeTask).
+//
+// With a one-thread context there is no pool, and a job is run as it
+// is submitted.  JobWait is not to be called from inside a pool task.
+// Freeing a context waits for all of its jobs to finish.
+// -------------------------------------------------------------------
+
+#define		JOB_HARDYZ			0
+#define		JOB_GRAM			1
+#define		JOB_GRAM_RANGE		2
+
+#define		JOB_QUEUED			0
+#define		JOB_RUNNING			1
+#define		JOB_DONE			2
+
+struct HGT_JOB {
+	struct HGT_JOB		*Next;		// in a pending list, then a completion queue
+	int					Type;		// JOB_HARDYZ and so on
+	int					Priority;	// HGT_JOB_URGENT and so on
+	int					State;		// JOB_QUEUED and so on
+	int					Status;		// what the computation returned
+	struct HGT_QUEUE	*Queue;		// NULL if none
+	bool				InQueue;	// posted to Queue, not yet taken
+	mpfr_t				Arg;		// t (Z) or N (Gram)
+	mpfr_t				Step;		// Incr (Z) or Accuracy (Gram)
+	uint64_t			Count;
+	mpfr_t				*Values;	// Count results
+	double				*Radius;	// for Z, the radius of each
+	pthread_mutex_t		Lock;
+	pthread_cond_t		Done;
+};
+
+struct HGT_JOBS {
+	pthread_mutex_t		Lock;
+	struct HGT_JOB		*Head[HGT_JOB_PRIORITIES];
+	struct HGT_JOB		*Tail[HGT_JOB_PRIORITIES];
+	struct HGT_BATCH	*Batch;		// the runner tasks
+};
+
+struct HGT_QUEUE {
+	pthread_mutex_t		Lock;
+	pthread_cond_t		Posted;
+	struct HGT_JOB		*Head;		// finished jobs, oldest first
+	struct HGT_JOB		*Tail;
+	uint64_t			Outstanding;	// submitted, not yet taken
+};
+
+// -------------------------------------------------------------------
+// A chunk of the points of a Z job, as a pool task (see JobExecute).
+// -------------------------------------------------------------------
+struct jobChunk {
+	struct HGT_JOB		*Job;
+	mpfr_t				t;			// t for point First
+	uint64_t			First;
+	uint64_t			Count;
+	int					Status;
+};
+
+static struct HGT_JOB *	JobCreate(int Type, int Priority, struct HGT_QUEUE *Queue,
+							mpfr_t Arg, mpfr_t Step, int StepBits, uint64_t Count);
+static bool				JobPriorityValid(int Priority);
+static bool				JobCountValid(uint64_t Count);
+static void				JobSubmit(struct HGT_JOB *Job);
+static void				JobRun(void *Arg);
+static int				JobExecute(struct HGT_JOB *Job);
+static int				JobHardyZRange(struct HGT_JOB *Job);
+static void				JobChunkTask(void *Arg);
+
+// *******************************************************************
+// Queue the computation of Z(t), Z(t + Incr), ... (Count values) at
+// the current context's precision and accuracy (see HardyZWithBall).
+// For a single point, Incr may be NULL.  Queue, if not NULL, is the
+// completion queue to post the job to when it finishes.  Returns the
+// job's handle, or NULL if Priority or Count (at most 
+// HGT_JOB_COUNT_MAX) is out of range or we are out of memory.  The
+// other Job functions return NULL in the same cases.
+// *******************************************************************
+struct HGT_JOB * JobHardyZ(mpfr_t t, mpfr_t Incr, uint64_t Count, int Priority,
+	struct HGT_QUEUE *Queue)
+{
+struct HGT_JOB		*Job;
+
+if(JobPriorityValid(Priority) == false || JobCountValid(Count) == false
+	|| (Count > 1 && Incr == NULL)) {
+	return(NULL);
+	}
+if((Job = JobCreate(JOB_HARDYZ, Priority, Queue, t, Incr, hgt_init.DefaultBits,
+	Count)) == NULL) {
+	return(NULL);
+	}
+JobSubmit(Job);
+return(Job);
+}
+
+// *******************************************************************
+// Queue the computation of the Gram point g_N (see GramAtN).
+// *******************************************************************
+struct HGT_JOB * JobGramAtN(mpfr_t N, mpfr_t Accuracy, int Priority,
+	struct HGT_QUEUE *Queue)
+{
+struct HGT_JOB		*Job;
+
+if(JobPriorityValid(Priority) == false) {
+	return(NULL);
+	}
+if((Job = JobCreate(JOB_GRAM, Priority, Queue, N, Accuracy, 
+	mpfr_get_prec(Accuracy), 1)) == NULL) {
+	return(NULL);
+	}
+JobSubmit(Job);
+return(Job);
+}
+
+// *******************************************************************
+// Queue the computation of the Gram points g_N through g_{N+Count-1}
+// (see GramRange).
+// *******************************************************************
+struct HGT_JOB * JobGramRange(mpfr_t N, uint64_t Count, mpfr_t Accuracy,
+	int Priority, struct HGT_QUEUE *Queue)
+{
+struct HGT_JOB		*Job;
+
+if(JobPriorityValid(Priority) == false || JobCountValid(Count) == false) {
+	return(NULL);
+	}
+if((Job = JobCreate(JOB_GRAM_RANGE, Priority, Queue, N, Accuracy,
+	mpfr_get_prec(Accuracy), Count)) == NULL) {
+	return(NULL);
+	}
+JobSubmit(Job);
+return(Job);
+}
+
+// *******************************************************************
+// True once the job has finished.
+// *******************************************************************
+bool JobReady(struct HGT_JOB *Job)
+{
+bool	Ready;
+
+pthread_mutex_lock(&Job->Lock);
+Ready = (Job->State == JOB_DONE) ? true : false;
+pthread_mutex_unlock(&Job->Lock);
+return(Ready);
+}
+
+// *******************************************************************
+// Wait until the job has finished, and return what the computation
+// returned (1 for success).
+// *******************************************************************
+int JobWait(struct HGT_JOB *Job)
+{
+uint64_t	Idle = 0;			// see hgtStats.c
+
+pthread_mutex_lock(&Job->Lock);
+while(Job->State != JOB_DONE) {
+	if(Idle == 0) {
+		Idle = StatsStart();
+		}
+	pthread_cond_wait(&Job->Done, &Job->Lock);
+	}
+pthread_mutex_unlock(&Job->Lock);
+StatsStop(HGT_STAGE_IDLE, Idle);
+return(Job->Status);
+}
+
+// *******************************************************************
+// The number of values the job computes.
+// *******************************************************************
+uint64_t JobCount(struct HGT_JOB *Job)
+{
+return(Job->Count);
+}
+
+// *******************************************************************
+// Copy value i of a finished job (0 <= i < JobCount) to Value, and
+// for Z, its radius to Radius (which may be NULL).  Returns 0 if the
+// job has not finished or i is out of range.
+// *******************************************************************
+int JobValue(struct HGT_JOB *Job, uint64_t i, mpfr_t *Value, double *Radius)
+{
+if(JobReady(Job) == false || i >= Job->Count) {
+	return(0);
+	}
+mpfr_set (*Value, Job->Values[i], MPFR_RNDN);
+if(Radius != NULL) {
+	*Radius = Job->Radius != NULL ? Job->Radius[i] : 0;
+	}
+return(1);
+}
+
+// *******************************************************************
+// Free a job, first waiting for it to finish (and taking it from its
+// completion queue, if it is still there).
+// *******************************************************************
+int JobFree(struct HGT_JOB *Job)
+{
+struct HGT_QUEUE	*Queue = Job->Queue;
+struct HGT_JOB		**Link, *Prev = NULL;
+uint64_t			i;
+
+JobWait(Job);
+if(Queue != NULL) {
+	pthread_mutex_lock(&Queue->Lock);
+	if(Job->InQueue == true) {
+		for(Link = &Queue->Head; *Link != Job; Link = &(*Link)->Next) {
+			Prev = *Link;
+			}
+		*Link = Job->Next;
+		if(Queue->Tail == Job) {
+			Queue->Tail = Prev;
+			}
+		Queue->Outstanding--;
+		}
+	pthread_mutex_unlock(&Queue->Lock);
+	}
+for(i = 0; i < Job->Count; i++) {
+	mpfr_clear (Job->Values[i]);
+	}
+mpfr_clears (Job->Arg, Job->Step, (mpfr_ptr) 0);
+pthread_mutex_destroy(&Job->Lock);
+pthread_cond_destroy(&Job->Done);
+free(Job->Radius);
+free(Job->Values);
+free(Job);
+return(1);
+}
+
+// *******************************************************************
+// Create and free a completion queue.  A queue may take jobs from any
+// number of threads and contexts.  It may be freed only when every
+// job posted to it has been taken (or freed).
+// *******************************************************************
+struct HGT_QUEUE * JobQueueCreate(void)
+{
+struct HGT_QUEUE	*Queue = calloc(1, sizeof(struct HGT_QUEUE));
+
+if(Queue != NULL) {
+	pthread_mutex_init(&Queue->Lock, NULL);
+	pthread_cond_init(&Queue->Posted, NULL);
+	}
+return(Queue);
+}
+
+int JobQueueFree(struct HGT_QUEUE *Queue)
+{
+uint64_t	Outstanding;
+
+pthread_mutex_lock(&Queue->Lock);
+Outstanding = Queue->Outstanding;
+pthread_mutex_unlock(&Queue->Lock);
+if(Outstanding != 0) {
+	return(0);
+	}
+pthread_mutex_destroy(&Queue->Lock);
+pthread_cond_destroy(&Queue->Posted);
+free(Queue);
+return(1);
+}
+
+// *******************************************************************
+// Take the next finished job from Queue, in the order they finished.
+// With Wait, block until one finishes; without, return NULL if none
+// has.  Also returns NULL if no job of the queue is left to take.
+// *******************************************************************
+struct HGT_JOB * JobQueueNext(struct HGT_QUEUE *Queue, bool Wait)
+{
+struct HGT_JOB		*Job;
+
+pthread_mutex_lock(&Queue->Lock);
+while(Queue->Head == NULL && Wait == true && Queue->Outstanding > 0) {
+	pthread_cond_wait(&Queue->Posted, &Queue->Lock);
+	}
+if((Job = Queue->Head) != NULL) {
+	Queue->Head = Job->Next;
+	if(Queue->Head == NULL) {
+		Queue->Tail = NULL;
+		}
+	Job->InQueue = false;
+	Queue->Outstanding--;
+	}
+pthread_mutex_unlock(&Queue->Lock);
+return(Job);
+}
+
+// -------------------------------------------------------------------
+// Create and free a context's job lists.  Called by ContextInit and
+// ContextClose (hgtInit.c); JobsFree waits for every job to finish.
+// JobsCreate returns NULL if we are out of memory, and the context
+// then takes no jobs (see JobCreate).
+// -------------------------------------------------------------------
+struct HGT_JOBS * JobsCreate(void)
+{
+struct HGT_JOBS		*Jobs = calloc(1, sizeof(struct HGT_JOBS));
+
+if(Jobs == NULL) {
+	return(NULL);
+	}
+if((Jobs->Batch = PoolBatchCreate()) == NULL) {
+	free(Jobs);
+	return(NULL);
+	}
+pthread_mutex_init(&Jobs->Lock, NULL);
+return(Jobs);
+}
+
+int JobsFree(struct HGT_JOBS *Jobs)
+{
+if(Jobs == NULL) {
+	return(1);
+	}
+PoolWaitBatch(Jobs->Batch);
+PoolBatchFree(Jobs->Batch);
+pthread_mutex_destroy(&Jobs->Lock);
+free(Jobs);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Make a job, copying its arguments and setting up Count results at
+// the current context's precision.  Step may be NULL (see JobHardyZ).
+// Returns NULL if we are out of memory, or the current context has
+// no job lists.
+// -------------------------------------------------------------------
+static struct HGT_JOB * JobCreate(int Type, int Priority, struct HGT_QUEUE *Queue,
+	mpfr_t Arg, mpfr_t Step, int StepBits, uint64_t Count)
+{
+struct HGT_JOB		*Job;
+uint64_t			i;
+
+if(hgt_current->Jobs == NULL 
+	|| (Job = calloc(1, sizeof(struct HGT_JOB))) == NULL) {
+	return(NULL);
+	}
+Job->Values = malloc(Count * sizeof(mpfr_t));
+if(Type == JOB_HARDYZ) {
+	Job->Radius = malloc(Count * sizeof(double));
+	}
+if(Job->Values == NULL || (Type == JOB_HARDYZ && Job->Radius == NULL)) {
+	free(Job->Radius);
+	free(Job->Values);
+	free(Job);
+	return(NULL);
+	}
+
+Job->Type	  = Type;
+Job->Priority = Priority;
+Job->State	  = JOB_QUEUED;
+Job->Queue	  = Queue;
+Job->Count	  = Count;
+mpfr_init2 (Job->Arg, mpfr_get_prec(Arg));
+mpfr_set (Job->Arg, Arg, MPFR_RNDN);
+mpfr_init2 (Job->Step, StepBits);
+if(Step != NULL) {
+	mpfr_set (Job->Step, Step, MPFR_RNDN);
+	}
+else {
+	mpfr_set_zero (Job->Step, 1);
+	}
+for(i = 0; i < Count; i++) {
+	mpfr_init2 (Job->Values[i], hgt_init.DefaultBits);
+	}
+pthread_mutex_init(&Job->Lock, NULL);
+pthread_cond_init(&Job->Done, NULL);
+return(Job);
+}
+
+// -------------------------------------------------------------------
+// True for HGT_JOB_URGENT, HGT_JOB_NORMAL and HGT_JOB_BULK.
+// -------------------------------------------------------------------
+static bool JobPriorityValid(int Priority)
+{
+return(Priority >= HGT_JOB_URGENT && Priority <= HGT_JOB_BULK);
+}
+
+// -------------------------------------------------------------------
+// True for a Count a job can hold (every value is kept until the job
+// is freed, so we set a much lower cap than HGT_COUNT_MAX).
+// -------------------------------------------------------------------
+static bool JobCountValid(uint64_t Count)
+{
+return(Count >= HGT_COUNT_MIN && Count <= HGT_JOB_COUNT_MAX);
+}
+
+// -------------------------------------------------------------------
+// Put a job on the current context's list for its priority, and a
+// runner task on its pool.
+// -------------------------------------------------------------------
+static void JobSubmit(struct HGT_JOB *Job)
+{
+struct HGT_JOBS		*Jobs = hgt_current->Jobs;
+int					p = Job->Priority;
+
+if(Job->Queue != NULL) {
+	pthread_mutex_lock(&Job->Queue->Lock);
+	Job->Queue->Outstanding++;
+	pthread_mutex_unlock(&Job->Queue->Lock);
+	}
+pthread_mutex_lock(&Jobs->Lock);
+if(Jobs->Tail[p] != NULL) {
+	Jobs->Tail[p]->Next = Job;
+	}
+else {
+	Jobs->Head[p] = Job;
+	}
+Jobs->Tail[p] = Job;
+pthread_mutex_unlock(&Jobs->Lock);
+PoolSubmit(Jobs->Batch, JobRun, Jobs);
+}
+
+// -------------------------------------------------------------------
+// A runner task: take the most urgent job queued, run it, then mark
+// it done and post it to its completion queue.
+// -------------------------------------------------------------------
+static void JobRun(void *Arg)
+{
+struct HGT_JOBS		*Jobs = Arg;
+struct HGT_JOB		*Job = NULL;
+struct HGT_QUEUE	*Queue;
+int					p, Status;
+
+pthread_mutex_lock(&Jobs->Lock);
+for(p = HGT_JOB_URGENT; p <= HGT_JOB_BULK && Job == NULL; p++) {
+	if((Job = Jobs->Head[p]) != NULL) {
+		Jobs->Head[p] = Job->Next;
+		if(Jobs->Head[p] == NULL) {
+			Jobs->Tail[p] = NULL;
+			}
+		}
+	}
+pthread_mutex_unlock(&Jobs->Lock);
+if(Job == NULL) {
+	return;							// one runner per job, so not expected
+	}
+
+pthread_mutex_lock(&Job->Lock);
+Job->State = JOB_RUNNING;
+Job->Next  = NULL;
+pthread_mutex_unlock(&Job->Lock);
+Status = JobExecute(Job);
+
+// -------------------------------------------------------------------
+// Mark the job done and post it while holding its queue's lock, so
+// that a job taken from the queue is always done, and JobFree (which
+// takes the queue's lock after JobWait) finds it posted.  Once done,
+// a job without a queue may be freed at any time, so we do not touch
+// it again.
+// -------------------------------------------------------------------
+if((Queue = Job->Queue) != NULL) {
+	pthread_mutex_lock(&Queue->Lock);
+	}
+pthread_mutex_lock(&Job->Lock);
+Job->Status = Status;
+Job->State	= JOB_DONE;
+pthread_cond_broadcast(&Job->Done);
+pthread_mutex_unlock(&Job->Lock);
+if(Queue != NULL) {
+	if(Queue->Tail != NULL) {
+		Queue->Tail->Next = Job;
+		}
+	else {
+		Queue->Head = Job;
+		}
+	Queue->Tail	 = Job;
+	Job->InQueue = true;
+	pthread_cond_broadcast(&Queue->Posted);
+	pthread_mutex_unlock(&Queue->Lock);
+	}
+}
+
+// -------------------------------------------------------------------
+// Do the computation.  A Z job of more than one point is split into
+// chunks (see JobHardyZRange).
+// -------------------------------------------------------------------
+static int JobExecute(struct HGT_JOB *Job)
+{
+struct computeHZ	comphz;
+int					Status = 0;
+
+switch(Job->Type) {
+	case JOB_HARDYZ:
+		if(Job->Count == 1) {
+			mpfr_inits2 (hgt_init.DefaultBits, comphz.t, comphz.Result, (mpfr_ptr) 0);
+			mpfr_set (comphz.t, Job->Arg, MPFR_RNDN);
+			Status = HardyZSingleBall(&comphz);
+			mpfr_set (Job->Values[0], comphz.Result, MPFR_RNDN);
+			Job->Radius[0] = comphz.Radius;
+			mpfr_clears (comphz.t, comphz.Result, (mpfr_ptr) 0);
+			}
+		else {
+			Status = JobHardyZRange(Job);
+			}
+		break;
+	case JOB_GRAM:
+		Status = GramAtN(&Job->Values[0], Job->Arg, Job->Step);
+		break;
+	case JOB_GRAM_RANGE:
+		Status = GramRange(Job->Values, Job->Arg, Job->Count, Job->Step);
+		break;
+	}
+return(Status);
+}
+
+// -------------------------------------------------------------------
+// The points of a Z job, in chunks of HGT_STREAM_CHUNK, each a pool 
+// task that writes its values and radii straight into the job.  The
+// 't' values come from adding Incr to 't' again and again, in order,
+// as in HardyZWithBall.  We run on a worker, so we must not block on
+// results the other workers may never get to: PoolWaitBatch has this
+// worker run the chunks no other worker has taken.
+// -------------------------------------------------------------------
+static int JobHardyZRange(struct HGT_JOB *Job)
+{
+struct jobChunk		*chunks;
+struct HGT_BATCH	*Batch;
+mpfr_t				localT;
+uint64_t			nChunks, c, i;
+int					Status = 1;
+
+nChunks = (Job->Count + HGT_STREAM_CHUNK - 1) / HGT_STREAM_CHUNK;
+chunks	= malloc(nChunks * sizeof(struct jobChunk));
+Batch	= PoolBatchCreate();
+if(chunks == NULL || Batch == NULL) {
+	free(chunks);
+	if(Batch != NULL) {
+		PoolBatchFree(Batch);
+		}
+	return(0);
+	}
+mpfr_init2 (localT, hgt_init.DefaultBits);
+mpfr_set (localT, Job->Arg, MPFR_RNDN);
+for(c = 0; c < nChunks; c++) {
+	chunks[c].Job	 = Job;
+	chunks[c].First	 = c * HGT_STREAM_CHUNK;
+	chunks[c].Count	 = Job->Count - chunks[c].First < HGT_STREAM_CHUNK 
+		? Job->Count - chunks[c].First : HGT_STREAM_CHUNK;
+	chunks[c].Status = 1;
+	mpfr_init2 (chunks[c].t, hgt_init.DefaultBits);
+	mpfr_set (chunks[c].t, localT, MPFR_RNDN);
+	for(i = 0; i < chunks[c].Count; i++) {
+		mpfr_add (localT, localT, Job->Step, MPFR_RNDN);
+		}
+	PoolSubmit(Batch, JobChunkTask, &chunks[c]);
+	}
+PoolWaitBatch(Batch);
+PoolBatchFree(Batch);
+
+for(c = 0; c < nChunks; c++) {
+	Status = chunks[c].Status == 0 ? 0 : Status;
+	mpfr_clear (chunks[c].t);
+	}
+mpfr_clear (localT);
+free(chunks);
+return(Status);
+}
+
+// -------------------------------------------------------------------
+// The pool task for a chunk of a Z job.
+// -------------------------------------------------------------------
+static void JobChunkTask(void *Arg)
+{
+struct jobChunk		*chunk = Arg;
+struct HGT_JOB		*Job = chunk->Job;
+struct computeHZ	comphz;
+uint64_t			i;
+
+mpfr_inits2 (hgt_init.DefaultBits, comphz.t, comphz.Result, (mpfr_ptr) 0);
+mpfr_set (comphz.t, chunk->t, MPFR_RNDN);
+for(i = chunk->First; i < chunk->First + chunk->Count; i++) {
+	if(HardyZSingleBall(&comphz) == 0) {
+		chunk->Status = 0;
+		}
+	mpfr_set (Job->Values[i], comphz.Result, MPFR_RNDN);
+	Job->Radius[i] = comphz.Radius;
+	mpfr_add (comphz.t, comphz.t, Job->Step, MPFR_RNDN);
+	}
+mpfr_clears (comphz.t, comphz.Result, (mpfr_ptr) 0);
+}
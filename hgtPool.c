@@ -0,0 +1,642 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#ifdef __linux__
+#define		_GNU_SOURCE				// for sched_getaffinity and friends
+#define		HGT_POOL_AFFINITY
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <mpfr.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file holds the library's worker pools.  Each context has its
+// own pool, created with the context (when more than one thread is
+// requested) and destroyed with it, so worker threads -- and the
+// per-thread MPFR caches, such as the cached value of pi -- live
+// across batches.  Tasks go to the pool of the submitting thread's
+// current context, and a worker runs every task with its own context
+// current.
+//
+// Each worker owns a double-ended queue of tasks.  Tasks submitted by
+// a worker go on its own queue, which it works from the bottom (most
+// recent first).  Tasks submitted from outside the pool go on a shared
+// first-in first-out queue.  A worker with nothing of its own takes
+// from the shared queue and then steals from the top (oldest end) of
+// the other workers' queues.
+//
+// A batch is a counter of unfinished tasks.  Callers wait for a whole
+// batch (PoolWaitBatch) or for a single task (PoolWaitItem); neither
+// waits on a barrier for a group of tasks.  A worker that waits
+// (a task that itself submits tasks) runs queued tasks of the batch it
+// waits for, and only those, so that an unrelated long task cannot
+// hold up the wait.  With none of them left to run, it sleeps until a
+// task of the batch finishes or is submitted.
+//
+// There is no limit on the number of workers other than
+// HGT_THREADS_MAX; a context asked for 0 threads gets one per CPU
+// (HardwareThreads).  On Linux, SetThreadAffinity can have the
+// workers of pools created later pinned, each to a CPU of its own
+// (HGT_AFFINITY_CORE) or to the CPUs of that CPU's NUMA node
+// (HGT_AFFINITY_NODE).  A worker pins itself before it does anything
+// else, so the memory it touches first -- its workspace (hgtWork.c)
+// and its MPFR caches -- comes from its own node.
+// -------------------------------------------------------------------
+
+struct poolTask {
+	pPoolTask			Func;
+	void				*Arg;
+	struct HGT_BATCH	*Batch;
+};
+
+struct HGT_BATCH {
+	pthread_mutex_t		Lock;
+	pthread_cond_t		Done;		// a task finished or was submitted
+	long				Remaining;	// tasks submitted but not finished
+	unsigned long		Submitted;	// tasks queued so far
+};
+
+struct poolDeque {
+	pthread_mutex_t		Lock;
+	struct poolTask		*Tasks;		// circular buffer
+	size_t				Capacity;	// power of 2
+	size_t				Top;		// steal end
+	size_t				Bottom;		// owner end
+};
+
+struct HGT_POOL {
+	struct HGT_CONTEXT	*Context;	// the context the pool belongs to
+	int					Workers;
+	int					Affinity;	// HGT_AFFINITY_ mode of the workers
+	atomic_int			Started;	// worker numbers handed out
+	pthread_t			*Threads;
+	struct poolDeque	*Deques;	// one per worker
+	struct poolDeque	Inject;		// tasks from outside the pool
+	atomic_long			Pending;	// tasks queued but not yet taken
+	pthread_mutex_t		Lock;
+	pthread_cond_t		Wake;
+	bool				Shutdown;
+};
+
+// the pool this thread works for (NULL for threads outside any pool),
+// and its worker number there
+static _Thread_local struct HGT_POOL	*poolSelf = NULL;
+static _Thread_local int				poolWorkerId = -1;
+
+// the affinity mode for pools created from now on, and (on Linux)
+// the CPUs this process may use, in order, and the node of each CPU
+static atomic_int						poolAffinity = HGT_AFFINITY_NONE;
+#ifdef HGT_POOL_AFFINITY
+static pthread_once_t					poolCpuOnce = PTHREAD_ONCE_INIT;
+static int								poolCpuCount = 0;
+static int								poolCpu[CPU_SETSIZE];
+static int								poolNodeOf[CPU_SETSIZE];
+
+static void		PoolFindCpus(void);
+#endif
+
+static void *	PoolWorker(void *Arg);
+static bool		PoolTakeTask(struct HGT_POOL *pool, int Self, struct HGT_BATCH *Only,
+					struct poolTask *Task);
+static void		PoolWaitUntil(struct HGT_BATCH *Batch, int *Done);
+static void		PoolRunTask(struct poolTask *Task);
+static void		PoolPin(int Affinity, int Id);
+static void		DequeInit(struct poolDeque *dq);
+static void		DequeClose(struct poolDeque *dq);
+static void		DequePush(struct poolDeque *dq, struct poolTask *Task);
+static bool		DequePopBottom(struct poolDeque *dq, struct HGT_BATCH *Only,
+					struct poolTask *Task);
+static bool		DequePopTop(struct poolDeque *dq, struct HGT_BATCH *Only,
+					struct poolTask *Task);
+
+// *******************************************************************
+// Create a pool for Context with the given number of worker threads.
+// With fewer than two workers we create no pool (and return NULL);
+// tasks then run on the submitting thread as they are submitted.
+// *******************************************************************
+struct HGT_POOL * PoolCreate(struct HGT_CONTEXT *Context, int Workers)
+{
+struct HGT_POOL		*pool;
+int					i;
+
+if(Workers < 2) {
+	return(NULL);
+	}
+pool = calloc(1, sizeof(struct HGT_POOL));
+pool->Context	= Context;
+pool->Workers	= Workers;
+pool->Affinity	= atomic_load(&poolAffinity);
+pool->Threads	= calloc(Workers, sizeof(pthread_t));
+pool->Deques	= calloc(Workers, sizeof(struct poolDeque));
+atomic_init(&pool->Pending, 0);
+atomic_init(&pool->Started, 0);
+pthread_mutex_init(&pool->Lock, NULL);
+pthread_cond_init(&pool->Wake, NULL);
+
+DequeInit(&pool->Inject);
+for(i = 0; i < Workers; i++) {
+	DequeInit(&pool->Deques[i]);
+	}
+for(i = 0; i < Workers; i++) {
+	pthread_create(&pool->Threads[i], NULL, PoolWorker, pool);
+	}
+return(pool);
+}
+
+// *******************************************************************
+// Stop and join all workers, then free the pool.  Tasks still queued
+// are run before the workers exit.
+// *******************************************************************
+int PoolDestroy(struct HGT_POOL *pool)
+{
+int		i;
+
+if(pool == NULL) {
+	return(1);
+	}
+pthread_mutex_lock(&pool->Lock);
+pool->Shutdown = true;
+pthread_cond_broadcast(&pool->Wake);
+pthread_mutex_unlock(&pool->Lock);
+
+for(i = 0; i < pool->Workers; i++) {
+	pthread_join(pool->Threads[i], NULL);
+	}
+DequeClose(&pool->Inject);
+for(i = 0; i < pool->Workers; i++) {
+	DequeClose(&pool->Deques[i]);
+	}
+pthread_mutex_destroy(&pool->Lock);
+pthread_cond_destroy(&pool->Wake);
+free(pool->Deques);
+free(pool->Threads);
+free(pool);
+return(1);
+}
+
+// *******************************************************************
+// The number of CPUs this process may run on (at least 1).  A context
+// asked for 0 threads gets this many.
+// *******************************************************************
+int HardwareThreads(void)
+{
+long	Count;
+
+#if defined(HGT_POOL_AFFINITY)
+pthread_once(&poolCpuOnce, PoolFindCpus);
+Count = poolCpuCount;
+#elif defined(_WIN32)
+Count = (long) GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+#else
+Count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+Count = Count < 1 ? 1 : Count;
+return((int) (Count > HGT_THREADS_MAX ? HGT_THREADS_MAX : Count));
+}
+
+// *******************************************************************
+// Choose how the workers of pools created from now on are placed:
+// HGT_AFFINITY_NONE (the default: as the system sees fit),
+// HGT_AFFINITY_CORE or HGT_AFFINITY_NODE.  Pinning is done only on
+// Linux; elsewhere the mode is accepted and ignored.  Returns 0 for an
+// unknown mode.
+// *******************************************************************
+int SetThreadAffinity(int Mode)
+{
+if(Mode < HGT_AFFINITY_NONE || Mode > HGT_AFFINITY_NODE) {
+	return(0);
+	}
+atomic_store(&poolAffinity, Mode);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// The number of threads that run pool tasks for the current context
+// (1 when it has no pool).
+// -------------------------------------------------------------------
+int PoolWorkers(void)
+{
+struct HGT_POOL		*pool = hgt_current->Pool;
+
+return(pool == NULL ? 1 : pool->Workers);
+}
+
+// -------------------------------------------------------------------
+// Create and free a batch (a count of unfinished tasks).
+// -------------------------------------------------------------------
+struct HGT_BATCH * PoolBatchCreate(void)
+{
+struct HGT_BATCH	*Batch = malloc(sizeof(struct HGT_BATCH));
+
+if(Batch != NULL) {
+	pthread_mutex_init(&Batch->Lock, NULL);
+	pthread_cond_init(&Batch->Done, NULL);
+	Batch->Remaining = 0;
+	Batch->Submitted = 0;
+	}
+return(Batch);
+}
+
+int PoolBatchFree(struct HGT_BATCH *Batch)
+{
+pthread_mutex_destroy(&Batch->Lock);
+pthread_cond_destroy(&Batch->Done);
+free(Batch);
+return(1);
+}
+
+// *******************************************************************
+// Submit one task to the current context's pool as part of Batch.  A
+// worker of that pool submits to its own queue; any other thread
+// submits to the shared queue.  Without a pool, the task is run right
+// away.
+// *******************************************************************
+int PoolSubmit(struct HGT_BATCH *Batch, pPoolTask Func, void *Arg)
+{
+struct HGT_POOL		*pool = hgt_current->Pool;
+struct poolTask		Task;
+
+Task.Func	= Func;
+Task.Arg	= Arg;
+Task.Batch	= Batch;
+
+pthread_mutex_lock(&Batch->Lock);
+Batch->Remaining++;
+pthread_mutex_unlock(&Batch->Lock);
+
+if(pool == NULL) {
+	PoolRunTask(&Task);
+	return(1);
+	}
+DequePush(poolSelf == pool ? &pool->Deques[poolWorkerId] : &pool->Inject, &Task);
+atomic_fetch_add(&pool->Pending, 1);
+
+pthread_mutex_lock(&pool->Lock);
+pthread_cond_signal(&pool->Wake);
+pthread_mutex_unlock(&pool->Lock);
+
+// -------------------------------------------------------------------
+// A worker waiting for this batch may run the task (see PoolWaitUntil).
+// -------------------------------------------------------------------
+pthread_mutex_lock(&Batch->Lock);
+Batch->Submitted++;
+pthread_cond_broadcast(&Batch->Done);
+pthread_mutex_unlock(&Batch->Lock);
+return(1);
+}
+
+// *******************************************************************
+// Wait until every task of Batch has finished.
+// *******************************************************************
+int PoolWaitBatch(struct HGT_BATCH *Batch)
+{
+PoolWaitUntil(Batch, NULL);
+return(1);
+}
+
+// *******************************************************************
+// A task calls PoolItemDone to mark its own result as ready, and a
+// caller uses PoolWaitItem to wait for that one result.  This lets a
+// caller consume results in order while later tasks of the same batch
+// are still running.
+// *******************************************************************
+int PoolItemDone(struct HGT_BATCH *Batch, int *Done)
+{
+pthread_mutex_lock(&Batch->Lock);
+*Done = 1;
+pthread_cond_broadcast(&Batch->Done);
+pthread_mutex_unlock(&Batch->Lock);
+return(1);
+}
+
+bool PoolItemReady(struct HGT_BATCH *Batch, int *Done)
+{
+bool	Ready;
+
+pthread_mutex_lock(&Batch->Lock);
+Ready = (*Done != 0) ? true : false;
+pthread_mutex_unlock(&Batch->Lock);
+return(Ready);
+}
+
+int PoolWaitItem(struct HGT_BATCH *Batch, int *Done)
+{
+PoolWaitUntil(Batch, Done);
+return(1);
+}
+
+// *******************************************************************
+// A caller that waits in some other way (see RingWait) calls PoolHelp
+// to run one queued task of Batch.  It returns false, having run
+// nothing, when the caller is not a pool worker or no task of Batch
+// could be taken.
+// *******************************************************************
+bool PoolHelp(struct HGT_BATCH *Batch)
+{
+struct HGT_POOL		*pool = poolSelf;
+struct poolTask		Task;
+
+if(pool == NULL || PoolTakeTask(pool, poolWorkerId, Batch, &Task) == false) {
+	return(false);
+	}
+PoolRunTask(&Task);
+return(true);
+}
+
+// -------------------------------------------------------------------
+// The code for PoolWaitBatch (Done is NULL) and PoolWaitItem.  A
+// worker of the current pool runs queued tasks of Batch while it
+// waits.  When there are none, it sleeps until a task of Batch 
+// finishes or is submitted; Submitted tells us whether one was 
+// submitted after we last looked, so that no wakeup is lost.  Only
+// the time spent with nothing to run counts as idle.
+// -------------------------------------------------------------------
+static void PoolWaitUntil(struct HGT_BATCH *Batch, int *Done)
+{
+struct HGT_POOL		*pool = poolSelf;
+struct poolTask		Task;
+unsigned long		Seen;
+uint64_t			Idle = 0;		// see hgtStats.c
+
+pthread_mutex_lock(&Batch->Lock);
+while(Done != NULL ? *Done == 0 : Batch->Remaining > 0) {
+	if(pool != NULL) {
+		Seen = Batch->Submitted;
+		pthread_mutex_unlock(&Batch->Lock);
+		if(PoolTakeTask(pool, poolWorkerId, Batch, &Task) == true) {
+			StatsStop(HGT_STAGE_IDLE, Idle);
+			Idle = 0;
+			PoolRunTask(&Task);
+			pthread_mutex_lock(&Batch->Lock);
+			continue;
+			}
+		pthread_mutex_lock(&Batch->Lock);
+		if(Seen != Batch->Submitted || (Done != NULL ? *Done != 0 : Batch->Remaining == 0)) {
+			continue;
+			}
+		}
+	if(Idle == 0) {
+		Idle = StatsStart();
+		}
+	pthread_cond_wait(&Batch->Done, &Batch->Lock);
+	}
+pthread_mutex_unlock(&Batch->Lock);
+StatsStop(HGT_STAGE_IDLE, Idle);
+}
+
+// -------------------------------------------------------------------
+// The worker thread loop: run our own tasks, then steal, then sleep
+// until more tasks are submitted.  On exit we release the workspace
+// and MPFR caches owned by this thread, and write out its trace events.
+// -------------------------------------------------------------------
+static void * PoolWorker(void *Arg)
+{
+struct HGT_POOL		*pool = Arg;
+struct poolTask		Task;
+uint64_t			Idle;
+
+poolSelf	 = pool;
+poolWorkerId = atomic_fetch_add(&pool->Started, 1);
+PoolPin(pool->Affinity, poolWorkerId);
+hgt_current	 = pool->Context;
+mpfr_set_default_prec (hgt_init.DefaultBits);
+for(;;) {
+	if(PoolTakeTask(pool, poolWorkerId, NULL, &Task) == true) {
+		PoolRunTask(&Task);
+		continue;
+		}
+	Idle = 0;
+	pthread_mutex_lock(&pool->Lock);
+	while(atomic_load(&pool->Pending) == 0 && pool->Shutdown == false) {
+		if(Idle == 0) {
+			Idle = StatsStart();
+			}
+		pthread_cond_wait(&pool->Wake, &pool->Lock);
+		}
+	StatsStop(HGT_STAGE_IDLE, Idle);
+	if(atomic_load(&pool->Pending) == 0 && pool->Shutdown == true) {
+		pthread_mutex_unlock(&pool->Lock);
+		break;
+		}
+	pthread_mutex_unlock(&pool->Lock);
+	}
+StatsThreadExit();
+WorkFree();
+mpfr_free_cache ();
+return(NULL);
+}
+
+// -------------------------------------------------------------------
+// Pin the calling worker (number Id) as Affinity asks.  Worker Id goes
+// to the Id-th CPU we may use (counting round again if there are more
+// workers than CPUs), or to every CPU of that CPU's node.
+// -------------------------------------------------------------------
+static void PoolPin(int Affinity, int Id)
+{
+#ifdef HGT_POOL_AFFINITY
+cpu_set_t	Set;
+int			i, Cpu;
+
+if(Affinity == HGT_AFFINITY_NONE) {
+	return;
+	}
+pthread_once(&poolCpuOnce, PoolFindCpus);
+if(poolCpuCount == 0) {
+	return;
+	}
+Cpu = poolCpu[Id % poolCpuCount];
+CPU_ZERO(&Set);
+for(i = 0; i < poolCpuCount; i++) {
+	if(poolCpu[i] == Cpu || (Affinity == HGT_AFFINITY_NODE 
+		&& poolNodeOf[poolCpu[i]] == poolNodeOf[Cpu])) {
+		CPU_SET(poolCpu[i], &Set);
+		}
+	}
+pthread_setaffinity_np(pthread_self(), sizeof(Set), &Set);
+#else
+(void) Affinity;
+(void) Id;
+#endif
+}
+
+#ifdef HGT_POOL_AFFINITY
+// -------------------------------------------------------------------
+// Find the CPUs this process may use, and the NUMA node of each, from
+// the lists in /sys/devices/system/node/node<k>/cpulist (such as
+// "0-15,32-47").  Without those lists, every CPU is on node 0.
+// -------------------------------------------------------------------
+static void PoolFindCpus(void)
+{
+cpu_set_t	Set;
+FILE		*File;
+char		Path[64];
+int			Cpu, Node, First, Last, Sep;
+
+if(sched_getaffinity(0, sizeof(Set), &Set) != 0) {
+	return;
+	}
+for(Cpu = 0; Cpu < CPU_SETSIZE; Cpu++) {
+	poolNodeOf[Cpu] = 0;
+	if(CPU_ISSET(Cpu, &Set)) {
+		poolCpu[poolCpuCount++] = Cpu;
+		}
+	}
+for(Node = 0; Node < HGT_NUMA_NODES_MAX; Node++) {
+	snprintf(Path, sizeof(Path), "/sys/devices/system/node/node%d/cpulist", Node);
+	if((File = fopen(Path, "r")) == NULL) {
+		continue;						// node numbers may have gaps
+		}
+	while(fscanf(File, "%d", &First) == 1) {
+		Last = First;
+		if((Sep = fgetc(File)) == '-') {
+			if(fscanf(File, "%d", &Last) != 1) {
+				break;
+				}
+			Sep = fgetc(File);
+			}
+		for(Cpu = First; Cpu <= Last && Cpu < CPU_SETSIZE; Cpu++) {
+			poolNodeOf[Cpu] = Node;
+			}
+		if(Sep != ',') {
+			break;
+			}
+		}
+	fclose(File);
+	}
+}
+#endif
+
+// -------------------------------------------------------------------
+// Take a task for worker Self: its own queue first, then the shared
+// queue, then steal.  If Only is not NULL, take only a task of that
+// batch, from the end of a queue (a task of the batch under others is
+// left where it is).
+// -------------------------------------------------------------------
+static bool PoolTakeTask(struct HGT_POOL *pool, int Self, struct HGT_BATCH *Only,
+	struct poolTask *Task)
+{
+int		i, Victim;
+
+if(DequePopBottom(&pool->Deques[Self], Only, Task) == true
+	|| DequePopTop(&pool->Inject, Only, Task) == true) {
+	atomic_fetch_sub(&pool->Pending, 1);
+	return(true);
+	}
+for(i = 1; i < pool->Workers; i++) {
+	Victim = (Self + i) % pool->Workers;
+	if(DequePopTop(&pool->Deques[Victim], Only, Task) == true) {
+		atomic_fetch_sub(&pool->Pending, 1);
+		return(true);
+		}
+	}
+return(false);
+}
+
+// -------------------------------------------------------------------
+// Run a task, then count it as done in its batch.
+// -------------------------------------------------------------------
+static void PoolRunTask(struct poolTask *Task)
+{
+struct HGT_BATCH	*Batch = Task->Batch;
+uint64_t			Start = StatsStart();
+
+Task->Func(Task->Arg);
+StatsStop(HGT_STAGE_TASK, Start);
+StatsCount(HGT_STAT_TASKS, 1);
+
+pthread_mutex_lock(&Batch->Lock);
+Batch->Remaining--;
+pthread_cond_broadcast(&Batch->Done);
+pthread_mutex_unlock(&Batch->Lock);
+}
+
+// -------------------------------------------------------------------
+// Deque operations.  The owner pushes and pops at the bottom; thieves
+// (and the shared queue's readers) pop at the top.  The buffer doubles
+// when it is full.  A pop with Only set takes the end task only if it
+// belongs to that batch.
+// -------------------------------------------------------------------
+static void DequeInit(struct poolDeque *dq)
+{
+pthread_mutex_init(&dq->Lock, NULL);
+dq->Capacity	= HGT_POOL_DEQUE_INIT;
+dq->Tasks		= malloc(HGT_POOL_DEQUE_INIT * sizeof(struct poolTask));
+dq->Top			= 0;
+dq->Bottom		= 0;
+}
+
+static void DequeClose(struct poolDeque *dq)
+{
+pthread_mutex_destroy(&dq->Lock);
+free(dq->Tasks);
+}
+
+static void DequePush(struct poolDeque *dq, struct poolTask *Task)
+{
+struct poolTask		*NewTasks;
+size_t				i;
+
+pthread_mutex_lock(&dq->Lock);
+if(dq->Bottom - dq->Top == dq->Capacity) {
+	NewTasks = malloc(2 * dq->Capacity * sizeof(struct poolTask));
+	for(i = dq->Top; i != dq->Bottom; i++) {
+		NewTasks[i & (2 * dq->Capacity - 1)] = dq->Tasks[i & (dq->Capacity - 1)];
+		}
+	free(dq->Tasks);
+	dq->Tasks = NewTasks;
+	dq->Capacity *= 2;
+	}
+dq->Tasks[dq->Bottom & (dq->Capacity - 1)] = *Task;
+dq->Bottom++;
+pthread_mutex_unlock(&dq->Lock);
+}
+
+static bool DequePopBottom(struct poolDeque *dq, struct HGT_BATCH *Only,
+	struct poolTask *Task)
+{
+bool	Found = false;
+
+pthread_mutex_lock(&dq->Lock);
+if(dq->Bottom != dq->Top && (Only == NULL 
+	|| dq->Tasks[(dq->Bottom - 1) & (dq->Capacity - 1)].Batch == Only)) {
+	dq->Bottom--;
+	*Task = dq->Tasks[dq->Bottom & (dq->Capacity - 1)];
+	Found = true;
+	}
+pthread_mutex_unlock(&dq->Lock);
+return(Found);
+}
+
+static bool DequePopTop(struct poolDeque *dq, struct HGT_BATCH *Only,
+	struct poolTask *Task)
+{
+bool	Found = false;
+
+pthread_mutex_lock(&dq->Lock);
+if(dq->Bottom != dq->Top && (Only == NULL 
+	|| dq->Tasks[dq->Top & (dq->Capacity - 1)].Batch == Only)) {
+	*Task = dq->Tasks[dq->Top & (dq->Capacity - 1)];
+	dq->Top++;
+	Found = true;
+	}
+pthread_mutex_unlock(&dq->Lock);
+return(Found);
+}
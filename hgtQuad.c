@@ -0,0 +1,207 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <quadmath.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file holds the __float128 (113-bit) backend, which sits between
+// the double-double backend in hgtBackend.c and the MPFR code.  The
+// functions here use libquadmath, so a program that links to libhgt.a
+// must also link with -lquadmath.
+//
+// The phase theta(t) - t log n is reduced modulo 2 pi using 2 pi as
+// an unevaluated sum of two __float128 values.
+// -------------------------------------------------------------------
+__extension__ typedef __float128	qfloat;
+
+static qfloat	qTwoPi[2];				// 2 pi as two __float128 values
+static qfloat	qPiOver8;
+static qfloat	qCoeff[GABCKE_NUM_Cj_TERMS][GABCKE_COEFF_PER_Cj];
+
+// -------------------------------------------------------------------
+// Convert an MPFR value to __float128 (Parts[0]) plus the remainder
+// (Parts[1]), using four non-overlapping doubles.
+// -------------------------------------------------------------------
+static void QuadFromMPFR(qfloat Parts[2], mpfr_t x)
+{
+mpfr_t	Temp1;
+double	d[4];
+qfloat	Exact;
+int		i;
+
+mpfr_init2 (Temp1, mpfr_get_prec(x));
+mpfr_set (Temp1, x, MPFR_RNDN);
+for(i = 0; i < 4; i++) {
+	d[i] = mpfr_get_d (Temp1, MPFR_RNDN);
+	mpfr_sub_d (Temp1, Temp1, d[i], MPFR_RNDN);
+	}
+mpfr_clear (Temp1);
+
+Exact	 = (qfloat) d[0] + (qfloat) d[1];		// exact: 106 bits or fewer
+Parts[0] = Exact + (qfloat) d[2];
+Parts[1] = ((Exact - Parts[0]) + (qfloat) d[2]) + (qfloat) d[3];
+}
+
+static void QuadToMPFR(mpfr_t *Result, qfloat q)
+{
+double	d;
+int		i;
+
+mpfr_set_zero (*Result, 1);
+for(i = 0; i < 3; i++) {				// 3 x 53 bits covers 113 bits
+	d = (double) q;
+	mpfr_add_d (*Result, *Result, d, MPFR_RNDN);
+	q -= (qfloat) d;
+	}
+}
+
+static qfloat QuadOf(mpfr_t x)
+{
+qfloat	Parts[2];
+
+QuadFromMPFR(Parts, x);
+return(Parts[0]);
+}
+
+// -------------------------------------------------------------------
+// Build the constants and the Gabcke coefficients for the __float128
+// backend.  This is called by InitCoeffMPFR.
+// -------------------------------------------------------------------
+int BuildCoefficientsQuad(void)
+{
+mpfr_t	Temp1;
+int		i, j;
+
+mpfr_init2 (Temp1, 256);
+mpfr_const_pi (Temp1, MPFR_RNDN);
+mpfr_mul_2ui (Temp1, Temp1, 1, MPFR_RNDN);
+QuadFromMPFR(qTwoPi, Temp1);
+mpfr_div_2ui (Temp1, Temp1, 4, MPFR_RNDN);
+qPiOver8 = QuadOf(Temp1);
+
+for(j = 0; j < GABCKE_NUM_Cj_TERMS; j++) {
+	for(i = 0; i < GABCKE_COEFF_PER_Cj; i++) {
+		CoeffBinToMPFR(&Temp1, j, i);
+		qCoeff[j][i] = QuadOf(Temp1);
+		}
+	}
+mpfr_clear (Temp1);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Reduce a modulo 2 pi to [-pi, pi].
+// -------------------------------------------------------------------
+static qfloat QuadReduce2Pi(qfloat a)
+{
+qfloat	k;
+
+k = nearbyintq(a / qTwoPi[0]);
+return((a - k * qTwoPi[0]) - k * qTwoPi[1]);
+}
+
+// -------------------------------------------------------------------
+// theta(t), using the same formula as ThetaOfT.
+// -------------------------------------------------------------------
+static qfloat QuadTheta(qfloat t)
+{
+qfloat	tOver2, Theta;
+
+tOver2 = t / 2;
+Theta  = tOver2 * (logq(t / qTwoPi[0]) - 1) + 1 / (48 * t) - qPiOver8;
+if(t < THETA_MAX_T_POWER3) {
+	Theta += 7 / (5760 * t * t * t);
+	}
+return(Theta);
+}
+
+static qfloat MainTermQuad(qfloat t, qfloat Theta, uint64_t N)
+{
+qfloat		Sum, c, y, s;
+uint64_t	n;
+
+Sum = cosq(QuadReduce2Pi(Theta));
+c	= 0;								// Kahan compensation
+for(n = 2; n <= N; n++) {
+	y	= cosq(QuadReduce2Pi(Theta - t * logq((qfloat) n))) / sqrtq((qfloat) n) - c;
+	s	= Sum + y;
+	c	= (s - Sum) - y;
+	Sum = s;
+	}
+return(2 * Sum);
+}
+
+static qfloat RemainderQuad(qfloat tFraction, bool nEven, qfloat P)
+{
+qfloat		AdjP, AdjP2, Cj, Total = 0, tPower = 1;
+int			i, j;
+
+AdjP  = 1 - 2 * P;
+AdjP2 = AdjP * AdjP;
+for(j = 0; j < GABCKE_NUM_Cj_TERMS; j++) {
+	Cj = 0;
+	for(i = GABCKE_COEFF_PER_Cj - 1; i >= 0; i--) {
+		Cj = Cj * AdjP2 + qCoeff[j][i];
+		}
+	if(j % 2 == 1) {
+		Cj *= AdjP;
+		}
+	Total  += tPower * Cj;
+	tPower *= tFraction * tFraction;
+	}
+return(nEven == true ? -tFraction * Total : tFraction * Total);
+}
+
+int ThetaOfT_Quad(mpfr_t *Theta, mpfr_t t)
+{
+QuadToMPFR(Theta, QuadTheta(QuadOf(t)));
+return(1);
+}
+
+int RS_MainTerm_Quad(mpfr_t *Result, mpfr_t t, uint64_t N)
+{
+qfloat	qt = QuadOf(t);
+
+if(N < 1) {
+	mpfr_set_ui (*Result, 0, MPFR_RNDN);
+	return(1);
+	}
+QuadToMPFR(Result, MainTermQuad(qt, QuadTheta(qt), N));
+return(1);
+}
+
+int RS_Remainder_Quad(mpfr_t *Result, mpfr_t tOver2Pi, bool nEven, mpfr_t P)
+{
+qfloat	tFraction;
+
+tFraction = sqrtq(1 / sqrtq(QuadOf(tOver2Pi)));
+QuadToMPFR(Result, RemainderQuad(tFraction, nEven, QuadOf(P)));
+return(1);
+}
+
+int HardyZ_Quad(mpfr_t *Result, mpfr_t t)
+{
+qfloat		qt, Root, P;
+uint64_t	N;
+
+qt	 = QuadOf(t);
+Root = sqrtq(qt / qTwoPi[0]);
+N	 = (uint64_t) floorq(Root);
+P	 = Root - (qfloat) N;
+QuadToMPFR(Result, MainTermQuad(qt, QuadTheta(qt), N)
+	+ RemainderQuad(sqrtq(1 / Root), N % 2 == 0, P));
+return(1);
+}
@@ -0,0 +1,118 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file holds the result ring, which passes finished results
+// from the pool workers (the producers) to a single consumer, in
+// index order.  The caller owns an array of Size records; record
+// Index lives in slot Index % Size.  The consumer hands out indexes
+// (as pool tasks) no more than Size ahead of the next one it will
+// consume, so a slot is never reused before it has been consumed.
+// Results may finish in any order within that window.
+//
+// Each slot has a sequence number.  A producer publishes record Index
+// by storing Index + 1 there; it takes no lock unless the consumer is
+// asleep.  The consumer first runs any of the producing tasks it can
+// take, then spins (HGT_RING_SPIN times), then sets
+// Sleeping and blocks on a condition variable.  A producer that sees
+// Sleeping set takes the lock and wakes it; since both sides use
+// sequentially consistent atomics, one of them always sees the other.
+// -------------------------------------------------------------------
+
+struct HGT_RING {
+	_Atomic uint64_t	*Seq;		// Index + 1 when record Index is done
+	uint64_t			Size;
+	atomic_bool			Sleeping;
+	pthread_mutex_t		Lock;
+	pthread_cond_t		Wake;
+};
+
+// *******************************************************************
+// Create and free a ring of Size slots.
+// *******************************************************************
+struct HGT_RING * RingCreate(uint64_t Size)
+{
+struct HGT_RING		*Ring = malloc(sizeof(struct HGT_RING));
+uint64_t			i;
+
+Ring->Size	= Size > 0 ? Size : 1;
+Ring->Seq	= malloc(Ring->Size * sizeof(_Atomic uint64_t));
+for(i = 0; i < Ring->Size; i++) {
+	atomic_init(&Ring->Seq[i], 0);
+	}
+atomic_init(&Ring->Sleeping, false);
+pthread_mutex_init(&Ring->Lock, NULL);
+pthread_cond_init(&Ring->Wake, NULL);
+return(Ring);
+}
+
+int RingFree(struct HGT_RING *Ring)
+{
+pthread_mutex_destroy(&Ring->Lock);
+pthread_cond_destroy(&Ring->Wake);
+free(Ring->Seq);
+free(Ring);
+return(1);
+}
+
+// *******************************************************************
+// A producer calls RingPublish once record Index is done.
+// *******************************************************************
+int RingPublish(struct HGT_RING *Ring, uint64_t Index)
+{
+atomic_store(&Ring->Seq[Index % Ring->Size], Index + 1);
+if(atomic_load(&Ring->Sleeping) == true) {
+	pthread_mutex_lock(&Ring->Lock);
+	pthread_cond_broadcast(&Ring->Wake);
+	pthread_mutex_unlock(&Ring->Lock);
+	}
+return(1);
+}
+
+// *******************************************************************
+// The consumer calls RingWait to wait until record Index is done.
+// Batch holds the tasks that produce the records.  A consumer that is
+// itself a pool worker first runs queued tasks of Batch (as
+// PoolWaitUntil does); otherwise a stream started from a pool task
+// could wait forever on tasks queued behind it.  Only the consumer
+// submits tasks of Batch, so once none can be taken, the rest are
+// left to the other workers and it spins and sleeps as before.
+// *******************************************************************
+int RingWait(struct HGT_RING *Ring, uint64_t Index, struct HGT_BATCH *Batch)
+{
+_Atomic uint64_t	*Seq = &Ring->Seq[Index % Ring->Size];
+int					i;
+
+while(atomic_load(Seq) != Index + 1 && PoolHelp(Batch) == true);
+
+for(i = 0; i < HGT_RING_SPIN; i++) {
+	if(atomic_load(Seq) == Index + 1) {
+		return(1);
+		}
+	sched_yield();
+	}
+
+pthread_mutex_lock(&Ring->Lock);
+atomic_store(&Ring->Sleeping, true);
+while(atomic_load(Seq) != Index + 1) {
+	pthread_cond_wait(&Ring->Wake, &Ring->Lock);
+	}
+atomic_store(&Ring->Sleeping, false);
+pthread_mutex_unlock(&Ring->Lock);
+return(1);
+}
@@ -0,0 +1,325 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define		HGT_SIMD_X86
+#endif
+
+
+// -------------------------------------------------------------------
+// This file holds the main-sum kernel for the double backend:
+//
+//		Sum = SUM_{n = nFirst}^{nLast}  n^{-1/2} cos(theta - t log n)
+//
+// where t and theta are double-double values.  The kernel is written
+// once, as the macro MAIN_SUM_KERNEL below, using the GCC vector
+// extensions.  It is compiled for 8 lanes (AVX-512), 4 lanes (AVX2)
+// and 1 lane (scalar), and MainSumDouble calls the widest version the
+// CPU supports (see __builtin_cpu_supports in BuildSimdTables).
+//
+// For each n the kernel computes:
+//
+//	 (1) log n in double-double.  With n = 2^e m, 1 <= m < 2, we take
+//		 c = 1 + k/128 (the leading 7 bits of m) and use
+//			 log m = log c + 2 atanh(s),	s = (m - c) / (m + c),
+//		 with log c from a table and |s| < 1/256, so six terms of the
+//		 atanh series suffice;
+//	 (2) the phase theta - t log n in double-double, then reduced
+//		 modulo 2 pi with 2 pi as three doubles;
+//	 (3) cos of the reduced phase in double, with a reduction to
+//		 [-pi/4, pi/4] and Taylor polynomials for sin and cos;
+//	 (4) the term, added to a per-lane compensated (two-sum) total.
+//
+// The exact products needed in (1) - (3) use fused multiply-add,
+// which is why each version of the kernel has its own FMA helper.
+// -------------------------------------------------------------------
+
+#define		SIMD_LOG_TABLE_BITS		7
+#define		SIMD_LOG_TABLE_SIZE		(1 << SIMD_LOG_TABLE_BITS)
+
+static double	LogTabHi[SIMD_LOG_TABLE_SIZE], LogTabLo[SIMD_LOG_TABLE_SIZE];
+static double	sTwoPi[3], sPiOver2[2], sLog2[2], sThird[2], sFifth[2];
+static double	sInvTwoPi, sTwoOverPi;
+static int		simdBest = HGT_SIMD_SCALAR;		// widest the CPU supports
+static int		simdLevel = HGT_SIMD_SCALAR;	// the one in use
+
+typedef double		vd1 __attribute__ ((vector_size (8)));
+typedef int64_t		vi1 __attribute__ ((vector_size (8)));
+
+static inline vd1 FmaV1(vd1 a, vd1 b, vd1 c)
+{
+vd1		r = { fma(a[0], b[0], c[0]) };
+
+return(r);
+}
+
+static inline vd1 SqrtV1(vd1 a)
+{
+vd1		r = { sqrt(a[0]) };
+
+return(r);
+}
+
+// -------------------------------------------------------------------
+// The kernel.  VD and VI are the vector types (W doubles, W int64_t),
+// FMA(a, b, c) must return a * b + c with one rounding, and SQRT is
+// the lane-wise square root.  ATTR gives the target for the version.
+// -------------------------------------------------------------------
+#define MAIN_SUM_KERNEL(NAME, ATTR, VD, VI, W, FMA, SQRT)					\
+ATTR static void NAME(double Sum[2], const double t[2],						\
+	const double Theta[2], uint64_t nFirst, uint64_t nLast)					\
+{																			\
+const double	Magic = 6755399441055744.0;			/* 1.5 * 2^52 */		\
+const VD		Zero = { 0 };												\
+VD		vn, m, c, cH, cL, d, aH, aL, bb, sH, sL, r, s2H, s2L, R;			\
+VD		vH, vL, pH, pL, uH, uL, s3H, s3L, wH, wL, lH, lL, e, eH, eL;		\
+VD		phH, phL, k, x, xl, j, y, z, SinP, CosP, Cos, Term;				\
+VD		Total = Zero, Comp = Zero, Step;									\
+VI		Bits, Idx, Quad, Mask;												\
+double	Res[2] = { 0.0, 0.0 }, s, b2;										\
+uint64_t	n;																\
+int		l;																	\
+																			\
+for(l = 0; l < W; l++) {													\
+	vn[l] = (double) (nFirst + l);											\
+	}																		\
+Step = Zero + (double) W;													\
+for(n = nFirst; n + W - 1 <= nLast; n += W, vn += Step) {					\
+	/* n = 2^e m, with m in [1, 2) and c = 1 + Idx / 128 */				\
+	Bits = (VI) vn;															\
+	e	 = (VD) ((Bits >> 52) | 0x4330000000000000LL)						\
+		   - (4503599627370496.0 + 1023.0);									\
+	Bits = (Bits & 0x000FFFFFFFFFFFFFLL) | 0x3FF0000000000000LL;			\
+	m	 = (VD) Bits;														\
+	c	 = (VD) (Bits & ~((1LL << (52 - SIMD_LOG_TABLE_BITS)) - 1));		\
+	Idx	 = (Bits >> (52 - SIMD_LOG_TABLE_BITS)) & (SIMD_LOG_TABLE_SIZE - 1);\
+	for(l = 0; l < W; l++) {												\
+		cH[l] = LogTabHi[Idx[l]];											\
+		cL[l] = LogTabLo[Idx[l]];											\
+		}																	\
+	/* s = (m - c) / (m + c) in double-double */							\
+	d  = m - c;																\
+	aH = m + c;																\
+	bb = aH - m;															\
+	aL = (m - (aH - bb)) + (c - bb);										\
+	sH = d / aH;															\
+	r  = FMA(-sH, aH, d) - sH * aL;											\
+	sL = r / aH;															\
+	s2H = sH * sH;															\
+	s2L = FMA(sH, sH, -s2H) + 2.0 * sH * sL;								\
+	/* U = 1/3 + s^2 (1/5 + s^2 R), R = 1/7 + s^2/9 + s^4/11 + s^6/13 */	\
+	R  = ((s2H * (1.0 / 13) + (1.0 / 11)) * s2H + (1.0 / 9)) * s2H			\
+		 + (1.0 / 7);														\
+	z  = s2H * R;															\
+	vH = sFifth[0] + z;														\
+	vL = ((sFifth[0] - vH) + z) + sFifth[1];								\
+	pH = s2H * vH;															\
+	pL = FMA(s2H, vH, -pH) + s2H * vL + s2L * vH;							\
+	uH = sThird[0] + pH;													\
+	bb = uH - sThird[0];													\
+	uL = ((sThird[0] - (uH - bb)) + (pH - bb)) + sThird[1] + pL;			\
+	/* W = s^3 U, then log m = log c + 2 (s + W) */							\
+	s3H = s2H * sH;															\
+	s3L = FMA(s2H, sH, -s3H) + s2H * sL + s2L * sH;							\
+	wH = s3H * uH;															\
+	wL = FMA(s3H, uH, -wH) + s3H * uL + s3L * uH;							\
+	lH = sH + wH;															\
+	lL = ((sH - lH) + wH) + sL + wL;										\
+	lH = 2.0 * lH;															\
+	lL = 2.0 * lL;															\
+	x  = cH + lH;															\
+	bb = x - cH;															\
+	lL = ((cH - (x - bb)) + (lH - bb)) + cL + lL;							\
+	lH = x;																	\
+	/* log n = e log 2 + log m */											\
+	eH = e * sLog2[0];														\
+	eL = FMA(e, Zero + sLog2[0], -eH) + e * sLog2[1];						\
+	x  = eH + lH;															\
+	bb = x - eH;															\
+	lL = ((eH - (x - bb)) + (lH - bb)) + eL + lL;							\
+	lH = x + lL;															\
+	lL = lL - (lH - x);														\
+	/* phase = theta - t log n */											\
+	pH	= t[0] * lH;														\
+	pL	= FMA(Zero + t[0], lH, -pH) + t[0] * lL + t[1] * lH;				\
+	phH = Theta[0] - pH;													\
+	bb	= phH - Theta[0];													\
+	phL = ((Theta[0] - (phH - bb)) - (pH + bb)) + Theta[1] - pL;			\
+	/* reduce modulo 2 pi; the first step is exact */						\
+	k  = (phH * sInvTwoPi + Magic) - Magic;									\
+	x  = FMA(-k, Zero + sTwoPi[0], phH);									\
+	xl = FMA(-k, Zero + sTwoPi[1], phL);									\
+	xl = FMA(-k, Zero + sTwoPi[2], xl);										\
+	y  = x + xl;															\
+	xl = xl - (y - x);														\
+	/* reduce to [-pi/4, pi/4], quadrant j */								\
+	j  = (y * sTwoOverPi + Magic) - Magic;									\
+	Quad = (VI) (j + Magic) & 3;											\
+	y  = FMA(-j, Zero + sPiOver2[0], y);									\
+	y  = FMA(-j, Zero + sPiOver2[1], y) + xl;								\
+	z  = y * y;																\
+	CosP = 1.0 + z * (-1.0 / 2 + z * (1.0 / 24 + z * (-1.0 / 720			\
+		 + z * (1.0 / 40320 + z * (-1.0 / 3628800 + z * (1.0 / 479001600	\
+		 + z * (-1.0 / 87178291200.0 + z * (1.0 / 20922789888000.0))))))));\
+	SinP = y + y * z * (-1.0 / 6 + z * (1.0 / 120 + z * (-1.0 / 5040		\
+		 + z * (1.0 / 362880 + z * (-1.0 / 39916800 + z * (1.0 / 6227020800.0\
+		 + z * (-1.0 / 1307674368000.0 + z * (1.0 / 355687428096000.0))))))));\
+	Mask = -(Quad & 1);														\
+	Cos	 = (VD) (((VI) SinP & Mask) | ((VI) CosP & ~Mask));					\
+	Cos	 = (VD) ((VI) Cos ^ (((Quad + 1) & 2) << 62));						\
+	/* compensated sum */													\
+	Term  = Cos / SQRT(vn);													\
+	x	  = Total + Term;													\
+	bb	  = x - Total;														\
+	Comp += (Total - (x - bb)) + (Term - bb);								\
+	Total = x;																\
+	}																		\
+for(l = 0; l < W; l++) {					/* combine the lanes */			\
+	s	   = Res[0] + Total[l];												\
+	b2	   = s - Res[0];														\
+	Res[1] += ((Res[0] - (s - b2)) + (Total[l] - b2)) + Comp[l];			\
+	Res[0] = s;																\
+	}																		\
+if(n <= nLast) {							/* fewer than W terms left */	\
+	MainSumScalar(Sum, t, Theta, n, nLast);									\
+	s	   = Res[0] + Sum[0];													\
+	b2	   = s - Res[0];														\
+	Res[1] += ((Res[0] - (s - b2)) + (Sum[0] - b2)) + Sum[1];				\
+	Res[0] = s;																\
+	}																		\
+Sum[0] = Res[0] + Res[1];													\
+Sum[1] = Res[1] - (Sum[0] - Res[0]);										\
+}
+
+static void MainSumScalar(double Sum[2], const double t[2],
+	const double Theta[2], uint64_t nFirst, uint64_t nLast);
+
+MAIN_SUM_KERNEL(MainSumScalar, , vd1, vi1, 1, FmaV1, SqrtV1)
+
+#ifdef HGT_SIMD_X86
+typedef int64_t		vi4 __attribute__ ((vector_size (32)));
+typedef int64_t		vi8 __attribute__ ((vector_size (64)));
+
+MAIN_SUM_KERNEL(MainSumAVX2, __attribute__ ((target ("avx2,fma"))),
+	__m256d, vi4, 4, _mm256_fmadd_pd, _mm256_sqrt_pd)
+MAIN_SUM_KERNEL(MainSumAVX512, __attribute__ ((target ("avx512f"))),
+	__m512d, vi8, 8, _mm512_fmadd_pd, _mm512_sqrt_pd)
+#endif
+
+// -------------------------------------------------------------------
+// Compute Sum = SUM_{n = nFirst}^{nLast} n^{-1/2} cos(theta - t log n)
+// as a double-double value, using the kernel chosen by SetSimdLevel.
+// -------------------------------------------------------------------
+int MainSumDouble(double Sum[2], const double t[2], const double Theta[2],
+	uint64_t nFirst, uint64_t nLast)
+{
+Sum[0] = Sum[1] = 0.0;
+if(nFirst > nLast) {
+	return(1);
+	}
+#ifdef HGT_SIMD_X86
+if(simdLevel == HGT_SIMD_AVX512) {
+	MainSumAVX512(Sum, t, Theta, nFirst, nLast);
+	return(1);
+	}
+if(simdLevel == HGT_SIMD_AVX2) {
+	MainSumAVX2(Sum, t, Theta, nFirst, nLast);
+	return(1);
+	}
+#endif
+MainSumScalar(Sum, t, Theta, nFirst, nLast);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Choose the kernel used by MainSumDouble.  A level wider than the
+// CPU supports is reduced to the widest it does support.  We return
+// the level now in use.
+// -------------------------------------------------------------------
+int SetSimdLevel(int Level)
+{
+simdLevel = Level > simdBest ? simdBest : Level;
+simdLevel = simdLevel < HGT_SIMD_SCALAR ? HGT_SIMD_SCALAR : simdLevel;
+return(simdLevel);
+}
+
+int SimdLevel(void)
+{
+return(simdLevel);
+}
+
+// -------------------------------------------------------------------
+// Build the log(1 + k/128) table and the constants used by the
+// kernel from 256-bit MPFR values, and find the widest kernel the CPU
+// supports.  This is called by InitCoeffMPFR.
+// -------------------------------------------------------------------
+int BuildSimdTables(void)
+{
+mpfr_t	Temp1, Temp2;
+double	Parts[3];
+int		k;
+
+mpfr_inits2 (256, Temp1, Temp2, (mpfr_ptr) 0);
+for(k = 0; k < SIMD_LOG_TABLE_SIZE; k++) {
+	mpfr_set_ui (Temp1, (unsigned long int) k, MPFR_RNDN);
+	mpfr_div_2ui (Temp1, Temp1, SIMD_LOG_TABLE_BITS, MPFR_RNDN);
+	mpfr_log1p (Temp1, Temp1, MPFR_RNDN);
+	MPFRToTripleDouble(Parts, Temp1);
+	LogTabHi[k] = Parts[0];
+	LogTabLo[k] = Parts[1];
+	}
+
+mpfr_const_pi (Temp1, MPFR_RNDN);
+mpfr_mul_2ui (Temp2, Temp1, 1, MPFR_RNDN);
+MPFRToTripleDouble(sTwoPi, Temp2);
+sInvTwoPi = 1.0 / sTwoPi[0];
+mpfr_div_2ui (Temp2, Temp1, 1, MPFR_RNDN);
+MPFRToTripleDouble(Parts, Temp2);
+sPiOver2[0] = Parts[0];
+sPiOver2[1] = Parts[1];
+sTwoOverPi	= 1.0 / sPiOver2[0];
+
+mpfr_const_log2 (Temp1, MPFR_RNDN);
+MPFRToTripleDouble(Parts, Temp1);
+sLog2[0] = Parts[0];
+sLog2[1] = Parts[1];
+mpfr_set_ui (Temp1, 1, MPFR_RNDN);
+mpfr_div_ui (Temp1, Temp1, 3, MPFR_RNDN);
+MPFRToTripleDouble(Parts, Temp1);
+sThird[0] = Parts[0];
+sThird[1] = Parts[1];
+mpfr_set_ui (Temp1, 1, MPFR_RNDN);
+mpfr_div_ui (Temp1, Temp1, 5, MPFR_RNDN);
+MPFRToTripleDouble(Parts, Temp1);
+sFifth[0] = Parts[0];
+sFifth[1] = Parts[1];
+mpfr_clears (Temp1, Temp2, (mpfr_ptr) 0);
+
+simdBest = HGT_SIMD_SCALAR;
+#ifdef HGT_SIMD_X86
+__builtin_cpu_init();
+if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+	simdBest = HGT_SIMD_AVX2;
+	}
+if(__builtin_cpu_supports("avx512f")) {
+	simdBest = HGT_SIMD_AVX512;
+	}
+#endif
+simdLevel = simdBest;
+return(1);
+}
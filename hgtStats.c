@@ -0,0 +1,283 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file holds the library's instrumentation.  It is compiled in,
+// but does nothing unless the context's debug flags ask for it (see
+// ContextInit in hgtInit.c):
+//
+//		HGT_DEBUG_STATS		per-thread counters and time per stage
+//		HGT_DEBUG_TRACE		the same, plus a timeline in Chrome trace
+//							(Perfetto) JSON format
+//
+// The hot path brackets each stage with StatsStart and StatsStop.
+// With instrumentation off, StatsStart returns 0 and StatsStop
+// returns at once.  Each thread's counters are kept in a block of its
+// own, written only by that thread, and StatsRead copies them out.
+// The blocks are kept (and so still counted) after a thread exits.
+//
+// For the timeline, each stage is a complete ("X") event on its
+// thread's track.  A thread buffers HGT_TRACE_EVENTS events and then
+// appends them to the trace file, which StatsTraceOpen starts (with
+// HGT_TRACE_FILE if HGT_DEBUG_TRACE is set) and StatsTraceClose (or
+// CloseMPFR) finishes.  As with CloseMPFR, no work may be in progress
+// when the trace is closed.
+// -------------------------------------------------------------------
+
+struct statsEvent {
+	int					Stage;
+	uint64_t			Start;			// ns
+	uint64_t			Duration;
+};
+
+struct statsThread {
+	struct statsThread	*Next;			// all threads, newest first
+	int					Id;
+	_Atomic uint64_t	Count[HGT_STAT_COUNTERS];
+	_Atomic uint64_t	Ns[HGT_STAGES];
+	struct statsEvent	*Events;		// trace buffer
+	int					nEvents;
+};
+
+static const char	*stageNames[HGT_STAGES] = {
+	"theta", "main", "remainder", "callback", "idle", "point", "task", "batch"
+};
+
+static pthread_mutex_t						statsLock = PTHREAD_MUTEX_INITIALIZER;
+static struct statsThread					*statsList = NULL;
+static int									statsNextId = 0;
+static FILE * _Atomic						traceFile = NULL;	// written under statsLock
+static uint64_t								traceBase = 0;
+static _Thread_local struct statsThread		*statsSelf = NULL;
+
+static uint64_t				StatsNow(void);
+static struct statsThread *	StatsThread(void);
+static void					StatsFlush(struct statsThread *st);
+
+// *******************************************************************
+// Start timing a stage.  Returns 0 (and costs next to nothing) when
+// instrumentation is off.
+// *******************************************************************
+uint64_t StatsStart(void)
+{
+return(hgt_init.Instrument == 0 ? 0 : StatsNow());
+}
+
+// *******************************************************************
+// Stop timing a stage started at Start, adding the time to this
+// thread's counters and (when tracing) to the timeline.
+// *******************************************************************
+void StatsStop(int Stage, uint64_t Start)
+{
+struct statsThread	*st;
+struct statsEvent	*ev;
+uint64_t			Now;
+
+if(Start == 0) {
+	return;
+	}
+Now = StatsNow();
+st	= StatsThread();
+atomic_fetch_add_explicit(&st->Ns[Stage], Now - Start, memory_order_relaxed);
+if((hgt_init.Instrument & HGT_INSTRUMENT_TRACE) != 0 
+	&& atomic_load_explicit(&traceFile, memory_order_acquire) != NULL) {
+	if(st->Events == NULL) {
+		st->Events = malloc(HGT_TRACE_EVENTS * sizeof(struct statsEvent));
+		}
+	ev = &st->Events[st->nEvents++];
+	ev->Stage	 = Stage;
+	ev->Start	 = Start;
+	ev->Duration = Now - Start;
+	if(st->nEvents == HGT_TRACE_EVENTS) {
+		pthread_mutex_lock(&statsLock);
+		StatsFlush(st);
+		pthread_mutex_unlock(&statsLock);
+		}
+	}
+}
+
+// *******************************************************************
+// Add n to one of this thread's counters (HGT_STAT_POINTS and so on).
+// *******************************************************************
+void StatsCount(int Counter, uint64_t n)
+{
+if(hgt_init.Instrument != 0) {
+	atomic_fetch_add_explicit(&StatsThread()->Count[Counter], n, memory_order_relaxed);
+	}
+}
+
+// *******************************************************************
+// Copy the counters of up to Max threads into Stats.  Returns the
+// number of threads that have counters (which may be more than Max).
+// Summing the Stats gives the totals for the process.
+// *******************************************************************
+int StatsRead(struct HGT_STATS *Stats, int Max)
+{
+struct statsThread	*st;
+int					i, n = 0;
+
+pthread_mutex_lock(&statsLock);
+for(st = statsList; st != NULL; st = st->Next, n++) {
+	if(n < Max) {
+		Stats[n].Thread = st->Id;
+		for(i = 0; i < HGT_STAT_COUNTERS; i++) {
+			Stats[n].Count[i] = atomic_load_explicit(&st->Count[i], memory_order_relaxed);
+			}
+		for(i = 0; i < HGT_STAGES; i++) {
+			Stats[n].Ns[i] = atomic_load_explicit(&st->Ns[i], memory_order_relaxed);
+			}
+		}
+	}
+pthread_mutex_unlock(&statsLock);
+return(n);
+}
+
+// *******************************************************************
+// Set every thread's counters back to zero.
+// *******************************************************************
+int StatsReset(void)
+{
+struct statsThread	*st;
+int					i;
+
+pthread_mutex_lock(&statsLock);
+for(st = statsList; st != NULL; st = st->Next) {
+	for(i = 0; i < HGT_STAT_COUNTERS; i++) {
+		atomic_store_explicit(&st->Count[i], 0, memory_order_relaxed);
+		}
+	for(i = 0; i < HGT_STAGES; i++) {
+		atomic_store_explicit(&st->Ns[i], 0, memory_order_relaxed);
+		}
+	}
+pthread_mutex_unlock(&statsLock);
+return(1);
+}
+
+// *******************************************************************
+// Start writing the timeline to FileName.  Returns 0 if the file
+// cannot be written (or a trace is already open).
+// *******************************************************************
+int StatsTraceOpen(const char *FileName)
+{
+struct statsThread	*st;
+int					Result = 0;
+
+pthread_mutex_lock(&statsLock);
+if(traceFile == NULL && (traceFile = fopen(FileName, "w")) != NULL) {
+	traceBase = StatsNow();
+	fprintf(traceFile, "[\n");
+	for(st = statsList; st != NULL; st = st->Next) {
+		fprintf(traceFile, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+			"\"tid\":%d,\"args\":{\"name\":\"thread %d\"}},\n", st->Id, st->Id);
+		}
+	Result = 1;
+	}
+pthread_mutex_unlock(&statsLock);
+return(Result);
+}
+
+// *******************************************************************
+// Write out every thread's buffered events and finish the file.
+// *******************************************************************
+int StatsTraceClose(void)
+{
+struct statsThread	*st;
+
+pthread_mutex_lock(&statsLock);
+if(traceFile != NULL) {
+	for(st = statsList; st != NULL; st = st->Next) {
+		StatsFlush(st);
+		}
+	fprintf(traceFile, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+		"\"args\":{\"name\":\"libhgt\"}}\n]\n");
+	fclose(traceFile);
+	traceFile = NULL;
+	}
+pthread_mutex_unlock(&statsLock);
+return(1);
+}
+
+// *******************************************************************
+// Called when a pool worker exits: write out its events and free its
+// trace buffer.  Its counters are kept.
+// *******************************************************************
+void StatsThreadExit(void)
+{
+if(statsSelf == NULL) {
+	return;
+	}
+pthread_mutex_lock(&statsLock);
+StatsFlush(statsSelf);
+free(statsSelf->Events);
+statsSelf->Events = NULL;
+pthread_mutex_unlock(&statsLock);
+statsSelf = NULL;
+}
+
+// -------------------------------------------------------------------
+// Monotonic time in ns.
+// -------------------------------------------------------------------
+static uint64_t StatsNow(void)
+{
+struct timespec	ts;
+
+clock_gettime(CLOCK_MONOTONIC, &ts);
+return((uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec);
+}
+
+// -------------------------------------------------------------------
+// This thread's block, created on first use.
+// -------------------------------------------------------------------
+static struct statsThread * StatsThread(void)
+{
+if(statsSelf == NULL) {
+	statsSelf = calloc(1, sizeof(struct statsThread));
+	pthread_mutex_lock(&statsLock);
+	statsSelf->Id	= statsNextId++;
+	statsSelf->Next = statsList;
+	statsList		= statsSelf;
+	if(traceFile != NULL) {
+		fprintf(traceFile, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+			"\"tid\":%d,\"args\":{\"name\":\"thread %d\"}},\n", statsSelf->Id,
+			statsSelf->Id);
+		}
+	pthread_mutex_unlock(&statsLock);
+	}
+return(statsSelf);
+}
+
+// -------------------------------------------------------------------
+// Append a thread's buffered events to the trace file (times in us
+// from the start of the trace).  The caller holds statsLock.
+// -------------------------------------------------------------------
+static void StatsFlush(struct statsThread *st)
+{
+struct statsEvent	*ev;
+int					i;
+
+if(traceFile != NULL) {
+	for(i = 0; i < st->nEvents; i++) {
+		ev = &st->Events[i];
+		fprintf(traceFile, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+			"\"ts\":%.3f,\"dur\":%.3f},\n", stageNames[ev->Stage], st->Id,
+			(double) (int64_t) (ev->Start - traceBase) / 1e3,
+			(double) ev->Duration / 1e3);
+		}
+	}
+st->nEvents = 0;
+}
@@ -0,0 +1,444 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file holds the optional table of log(n) and 1/sqrt(n).  These
+// values do not depend on t, so rather than have RS_MainTerm compute
+// them again for every t, we can keep them in a binary file that is
+// shared by every thread (and every process) using the same precision
+// and backend.  There is one file for each (backend, precision) pair:
+//
+//		<Dir>/hgt-mpfr-<bits>.tab		MPFR values, <bits> precision
+//		<Dir>/hgt-dd.tab				double-double values
+//
+// The file is a header followed by one entry for each n = 1, 2, ....
+// An MPFR entry is two values (log n, then 1/sqrt(n)), each stored as
+// its kind, its exponent and its limbs, so that TableViewMPFR can
+// point an mpfr_t at the limbs in the file without copying them (see
+// mpfr_custom_init_set).  A double-double entry is four doubles.
+//
+// The table is built lazily: when a caller needs n up to N and the
+// file holds fewer entries, we append entries (at least half again as
+// many as the file holds) and map the file again.  On POSIX systems
+// the file is memory-mapped read-only and growth is serialized across
+// processes by flock; on Windows the file is read into memory.
+//
+// Callers bracket their use of the table with TableAcquire and
+// TableRelease.  Between the two, the returned pointer remains valid
+// (growth waits for all readers to release the table).
+// -------------------------------------------------------------------
+
+#define		TABLE_MAGIC			"HGTLOGT1"
+#define		TABLE_VERSION		1
+#define		TABLE_HEADER_SIZE	64
+#define		TABLE_CHUNK			4096		// entries computed per write
+
+struct tableHeader {
+	char		Magic[8];
+	uint32_t	Version;
+	uint32_t	Backend;
+	uint32_t	Bits;
+	uint32_t	LimbBytes;
+	uint64_t	EntrySize;
+	uint64_t	Count;					// entries in the file (n = 1..Count)
+};
+
+struct tableValue {						// one MPFR value in an entry
+	int64_t		Kind;
+	int64_t		Exp;
+	// followed by the limbs
+};
+
+struct hgtTable {
+	pthread_rwlock_t	Lock;
+	bool				Open;
+	int					Backend;
+	int					Bits;
+	FILE				*File;
+	uint64_t			Count;			// entries mapped
+	size_t				ValueSize;		// MPFR: bytes per value
+	size_t				EntrySize;
+	unsigned char		*Map;			// header + entries
+	size_t				MapSize;
+};
+
+static struct hgtTable	tables[2] = {
+	{ .Lock = PTHREAD_RWLOCK_INITIALIZER },
+	{ .Lock = PTHREAD_RWLOCK_INITIALIZER }
+};
+
+// -------------------------------------------------------------------
+// The table slot for the given backend, or NULL if the backend has no
+// table.
+// -------------------------------------------------------------------
+static struct hgtTable *TableFor(int Backend)
+{
+if(Backend == HGT_BACKEND_MPFR) {
+	return(&tables[0]);
+	}
+if(Backend == HGT_BACKEND_DD) {
+	return(&tables[1]);
+	}
+return(NULL);
+}
+
+// -------------------------------------------------------------------
+// Lock and unlock the file against other processes.
+// -------------------------------------------------------------------
+static void TableLockFile(struct hgtTable *tab, bool Lock)
+{
+#ifndef _WIN32
+flock(fileno(tab->File), Lock ? LOCK_EX : LOCK_UN);
+#else
+(void) tab;
+(void) Lock;
+#endif
+}
+
+static void TableUnmap(struct hgtTable *tab)
+{
+if(tab->Map != NULL) {
+#ifndef _WIN32
+	munmap(tab->Map, tab->MapSize);
+#else
+	free(tab->Map);
+#endif
+	}
+tab->Map	 = NULL;
+tab->MapSize = 0;
+tab->Count	 = 0;
+}
+
+// -------------------------------------------------------------------
+// Map (or, on Windows, read) the first Count entries of the file.
+// -------------------------------------------------------------------
+static int TableMap(struct hgtTable *tab, uint64_t Count)
+{
+size_t		Size = TABLE_HEADER_SIZE + Count * tab->EntrySize;
+
+TableUnmap(tab);
+if(Count == 0) {
+	return(1);
+	}
+fflush(tab->File);
+#ifndef _WIN32
+tab->Map = mmap(NULL, Size, PROT_READ, MAP_SHARED, fileno(tab->File), 0);
+if(tab->Map == MAP_FAILED) {
+	tab->Map = NULL;
+	return(0);
+	}
+#else
+if((tab->Map = malloc(Size)) == NULL) {
+	return(0);
+	}
+rewind(tab->File);
+if(fread(tab->Map, 1, Size, tab->File) != Size) {
+	free(tab->Map);
+	tab->Map = NULL;
+	return(0);
+	}
+#endif
+tab->MapSize = Size;
+tab->Count	 = Count;
+return(1);
+}
+
+static int TableReadHeader(struct hgtTable *tab, struct tableHeader *Header)
+{
+rewind(tab->File);
+return(fread(Header, sizeof(*Header), 1, tab->File) == 1);
+}
+
+static int TableWriteHeader(struct hgtTable *tab, uint64_t Count)
+{
+struct tableHeader	Header;
+unsigned char		Buffer[TABLE_HEADER_SIZE];
+
+memset(&Header, 0, sizeof(Header));
+memcpy(Header.Magic, TABLE_MAGIC, 8);
+Header.Version	 = TABLE_VERSION;
+Header.Backend	 = (uint32_t) tab->Backend;
+Header.Bits		 = (uint32_t) tab->Bits;
+Header.LimbBytes = (uint32_t) sizeof(mp_limb_t);
+Header.EntrySize = tab->EntrySize;
+Header.Count	 = Count;
+memset(Buffer, 0, sizeof(Buffer));
+memcpy(Buffer, &Header, sizeof(Header));
+rewind(tab->File);
+if(fwrite(Buffer, sizeof(Buffer), 1, tab->File) != 1) {
+	return(0);
+	}
+return(fflush(tab->File) == 0);
+}
+
+// -------------------------------------------------------------------
+// Store one MPFR value (at Dest) in the table format.
+// -------------------------------------------------------------------
+static void TablePutMPFR(struct hgtTable *tab, unsigned char *Dest, mpfr_t x)
+{
+struct tableValue	Value;
+
+memset(Dest, 0, tab->ValueSize);
+Value.Kind = mpfr_custom_get_kind(x);
+Value.Exp  = Value.Kind == MPFR_REGULAR_KIND ? mpfr_custom_get_exp(x) : 0;
+memcpy(Dest, &Value, sizeof(Value));
+if(Value.Kind == MPFR_REGULAR_KIND) {
+	memcpy(Dest + sizeof(Value), mpfr_custom_get_significand(x),
+		mpfr_custom_get_size(tab->Bits));
+	}
+}
+
+// -------------------------------------------------------------------
+// Append the entries for n = From..To to the file.  We compute them
+// the same way RS_MainTerm does, so using the table does not change
+// any result.
+// -------------------------------------------------------------------
+static int TableAppend(struct hgtTable *tab, uint64_t From, uint64_t To)
+{
+unsigned char	*Buffer, *Entry;
+mpfr_t			n, Log, Recip;
+double			Parts[3], *dd;
+uint64_t		i, Last;
+int				Result = 1;
+
+if((Buffer = malloc(TABLE_CHUNK * tab->EntrySize)) == NULL) {
+	return(0);
+	}
+mpfr_inits2 (tab->Backend == HGT_BACKEND_MPFR ? tab->Bits : 256,
+	n, Log, Recip, (mpfr_ptr) 0);
+fseeko(tab->File, (off_t) (TABLE_HEADER_SIZE + (From - 1) * tab->EntrySize), SEEK_SET);
+while(From <= To && Result == 1) {
+	Last = From + TABLE_CHUNK - 1 < To ? From + TABLE_CHUNK - 1 : To;
+	for(i = From, Entry = Buffer; i <= Last; i++, Entry += tab->EntrySize) {
+		mpfr_set_uj (n, i, MPFR_RNDN);
+		mpfr_log (Log, n, MPFR_RNDN);
+		mpfr_rec_sqrt (Recip, n, MPFR_RNDN);
+		if(tab->Backend == HGT_BACKEND_MPFR) {
+			TablePutMPFR(tab, Entry, Log);
+			TablePutMPFR(tab, Entry + tab->ValueSize, Recip);
+			}
+		else {
+			dd = (double *) Entry;
+			MPFRToTripleDouble(Parts, Log);
+			dd[0] = Parts[0];
+			dd[1] = Parts[1];
+			MPFRToTripleDouble(Parts, Recip);
+			dd[2] = Parts[0];
+			dd[3] = Parts[1];
+			}
+		}
+	if(fwrite(Buffer, tab->EntrySize, Last - From + 1, tab->File) != Last - From + 1) {
+		Result = 0;
+		}
+	From = Last + 1;
+	}
+mpfr_clears (n, Log, Recip, (mpfr_ptr) 0);
+free(Buffer);
+return(Result == 1 ? fflush(tab->File) == 0 : 0);
+}
+
+// -------------------------------------------------------------------
+// Make sure the table holds at least N entries.  The caller holds the
+// write lock.
+// -------------------------------------------------------------------
+static int TableGrow(struct hgtTable *tab, uint64_t N)
+{
+struct tableHeader	Header;
+uint64_t			Target;
+int					Result = 1;
+
+TableLockFile(tab, true);
+if(TableReadHeader(tab, &Header) == 0) {
+	TableLockFile(tab, false);
+	return(0);
+	}
+if(Header.Count < N) {						// another process may have grown it
+	Target = Header.Count + Header.Count / 2;
+	Target = Target > N ? Target : N;
+	Result = TableAppend(tab, Header.Count + 1, Target);
+	if(Result == 1) {
+		Result = TableWriteHeader(tab, Target);
+		Header.Count = Target;
+		}
+	}
+if(Result == 1) {
+	Result = TableMap(tab, Header.Count);
+	}
+TableLockFile(tab, false);
+return(Result);
+}
+
+// -------------------------------------------------------------------
+// Open (creating it if needed) the table for the given backend in the
+// directory Dir.  An MPFR table uses the current default precision.
+// Returns 1 on success and 0 if the file cannot be used (for example
+// a file with the right name but a different layout).
+// -------------------------------------------------------------------
+int TableOpen(const char *Dir, int Backend)
+{
+struct hgtTable		*tab = TableFor(Backend);
+struct tableHeader	Header;
+char				Path[1024];
+int					Result = 1;
+
+if(tab == NULL) {
+	return(0);
+	}
+TableClose(Backend);
+pthread_rwlock_wrlock(&tab->Lock);
+tab->Backend = Backend;
+if(Backend == HGT_BACKEND_MPFR) {
+	tab->Bits	   = hgt_init.DefaultBits;
+	tab->ValueSize = sizeof(struct tableValue) + mpfr_custom_get_size(tab->Bits);
+	tab->ValueSize = (tab->ValueSize + 7) & ~((size_t) 7);
+	tab->EntrySize = 2 * tab->ValueSize;
+	snprintf(Path, sizeof(Path), "%s/hgt-mpfr-%d.tab", Dir, tab->Bits);
+	}
+else {
+	tab->Bits	   = 106;
+	tab->ValueSize = 2 * sizeof(double);
+	tab->EntrySize = 4 * sizeof(double);
+	snprintf(Path, sizeof(Path), "%s/hgt-dd.tab", Dir);
+	}
+
+if((tab->File = fopen(Path, "r+b")) == NULL) {
+	tab->File = fopen(Path, "w+b");
+	}
+if(tab->File == NULL) {
+	pthread_rwlock_unlock(&tab->Lock);
+	return(0);
+	}
+
+TableLockFile(tab, true);
+if(TableReadHeader(tab, &Header) == 0) {	// new (empty) file
+	Header.Count = 0;
+	Result = TableWriteHeader(tab, 0);
+	}
+else if(memcmp(Header.Magic, TABLE_MAGIC, 8) != 0
+		|| Header.Version != TABLE_VERSION
+		|| Header.Backend != (uint32_t) Backend
+		|| Header.Bits != (uint32_t) tab->Bits
+		|| Header.LimbBytes != (uint32_t) sizeof(mp_limb_t)
+		|| Header.EntrySize != tab->EntrySize) {
+	Result = 0;
+	}
+if(Result == 1) {
+	Result = TableMap(tab, Header.Count);
+	}
+TableLockFile(tab, false);
+
+if(Result == 0) {
+	fclose(tab->File);
+	tab->File = NULL;
+	}
+tab->Open = Result == 1;
+pthread_rwlock_unlock(&tab->Lock);
+return(Result);
+}
+
+// -------------------------------------------------------------------
+// Close the table for the given backend (if open).  Also called for
+// both backends when the last context is closed (see hgtInit.c).
+// -------------------------------------------------------------------
+int TableClose(int Backend)
+{
+struct hgtTable		*tab = TableFor(Backend);
+
+if(tab == NULL) {
+	return(0);
+	}
+pthread_rwlock_wrlock(&tab->Lock);
+if(tab->Open == true) {
+	TableUnmap(tab);
+	fclose(tab->File);
+	tab->File = NULL;
+	tab->Open = false;
+	}
+pthread_rwlock_unlock(&tab->Lock);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Return a pointer to the entries for n = 1..N (growing the table if
+// needed), or NULL if there is no table open for this backend (or, for
+// MPFR, if the table precision is not Bits).  On a non-NULL return the
+// caller must call TableRelease when done.
+// -------------------------------------------------------------------
+const void *TableAcquire(int Backend, int Bits, uint64_t N)
+{
+struct hgtTable		*tab = TableFor(Backend);
+
+if(tab == NULL || tab->Open == false) {
+	return(NULL);
+	}
+for(;;) {
+	pthread_rwlock_rdlock(&tab->Lock);
+	if(tab->Open == false || (Backend == HGT_BACKEND_MPFR && tab->Bits != Bits)) {
+		pthread_rwlock_unlock(&tab->Lock);
+		return(NULL);
+		}
+	if(tab->Count >= N) {
+		return(tab->Map + TABLE_HEADER_SIZE);
+		}
+	pthread_rwlock_unlock(&tab->Lock);
+
+	pthread_rwlock_wrlock(&tab->Lock);
+	if(tab->Open == true && tab->Count < N && TableGrow(tab, N) == 0) {
+		pthread_rwlock_unlock(&tab->Lock);
+		return(NULL);
+		}
+	pthread_rwlock_unlock(&tab->Lock);
+	}
+}
+
+int TableRelease(int Backend)
+{
+struct hgtTable		*tab = TableFor(Backend);
+
+if(tab == NULL) {
+	return(0);
+	}
+pthread_rwlock_unlock(&tab->Lock);
+return(1);
+}
+
+// -------------------------------------------------------------------
+// Point Log and RecipSqrt at the stored values of log n and 1/sqrt(n)
+// in an MPFR table (no copy is made).  Log and RecipSqrt must not be
+// initialized or cleared, and must not be written to.
+// -------------------------------------------------------------------
+int TableViewMPFR(const void *Entries, uint64_t n, mpfr_t Log, mpfr_t RecipSqrt)
+{
+const struct hgtTable	*tab = &tables[0];
+const unsigned char		*Entry;
+struct tableValue		Value;
+
+Entry = (const unsigned char *) Entries + (n - 1) * tab->EntrySize;
+memcpy(&Value, Entry, sizeof(Value));
+mpfr_custom_init_set(Log, (int) Value.Kind, (mpfr_exp_t) Value.Exp, tab->Bits,
+	(void *) (Entry + sizeof(Value)));
+Entry += tab->ValueSize;
+memcpy(&Value, Entry, sizeof(Value));
+mpfr_custom_init_set(RecipSqrt, (int) Value.Kind, (mpfr_exp_t) Value.Exp, tab->Bits,
+	(void *) (Entry + sizeof(Value)));
+return(1);
+}
@@ -0,0 +1,148 @@
+// -------------------------------------------------------------------
+// Program last modified October 16, 2026.
+// Copyright (c) 2026 Terrence P. Murphy
+// MIT License -- see hgt.h for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+
+// -------------------------------------------------------------------
+// This file holds the per-thread workspace for MPFR temporaries.  The
+// routines on the Hardy Z path (HardyZSingle, RS_MainTerm,
+// RS_Remainder, ThetaOfT, GramAtN and so on) need a few dozen
+// temporaries per call; with mpfr_inits2 and mpfr_clears, each one is
+// a malloc and a free.  Instead, each thread has a stack of memory
+// blocks, and WorkInits points each temporary (an ordinary mpfr_t
+// on the caller's stack) at limbs taken from the top of it, with
+// mpfr_custom_init_set.  A routine takes a mark with WorkMark before
+// WorkInits, and gives everything back with WorkRelease(Mark).
+//
+// Blocks are kept once allocated, so after the first few calls on a
+// thread no heap allocation is done at all.  Because the memory is
+// used as a stack, nesting is fine, including a pool worker that runs
+// other tasks while it waits (see PoolWaitBatch).  The rules for
+// these temporaries are those for any custom MPFR variable: do not
+// change their precision, do not mpfr_clear them, do not mpfr_swap
+// them with an ordinary variable, and do not use them after the
+// release.
+// -------------------------------------------------------------------
+
+struct workBlock {
+	struct workBlock	*Prev;			// next block down the stack
+	size_t				Size;
+	size_t				Used;
+	max_align_t			Data[];
+};
+
+static _Thread_local struct workBlock	*workTop  = NULL;	// in use
+static _Thread_local struct workBlock	*workFree = NULL;	// kept for reuse
+
+static void *	WorkAlloc(size_t Bytes);
+
+// *******************************************************************
+// Note where the top of this thread's workspace is.
+// *******************************************************************
+struct HGT_WORKMARK WorkMark(void)
+{
+struct HGT_WORKMARK		Mark;
+
+Mark.Block = workTop;
+Mark.Used  = workTop != NULL ? workTop->Used : 0;
+return(Mark);
+}
+
+// *******************************************************************
+// Set up each of the (NULL terminated) variables as a temporary of
+// Bits precision, as mpfr_inits2 would.  Each starts out as NaN.
+// *******************************************************************
+void WorkInits(int Bits, mpfr_ptr x, ...)
+{
+va_list		Args;
+size_t		Bytes = mpfr_custom_get_size(Bits);
+void		*Limbs;
+
+Bytes = (Bytes + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+va_start(Args, x);
+while(x != NULL) {
+	Limbs = WorkAlloc(Bytes);
+	mpfr_custom_init(Limbs, Bits);
+	mpfr_custom_init_set(x, MPFR_NAN_KIND, 0, Bits, Limbs);
+	x = va_arg(Args, mpfr_ptr);
+	}
+va_end(Args);
+}
+
+// *******************************************************************
+// Give back everything taken since Mark.
+// *******************************************************************
+void WorkRelease(struct HGT_WORKMARK Mark)
+{
+struct workBlock	*Block;
+
+while(workTop != Mark.Block) {
+	Block	   = workTop;
+	workTop	   = Block->Prev;
+	Block->Prev = workFree;
+	workFree   = Block;
+	}
+if(workTop != NULL) {
+	workTop->Used = Mark.Used;
+	}
+}
+
+// *******************************************************************
+// Free this thread's workspace.  Called when a pool worker exits, and
+// by CloseMPFR for the calling thread.
+// *******************************************************************
+void WorkFree(void)
+{
+struct workBlock	*Block;
+
+WorkRelease((struct HGT_WORKMARK) { NULL, 0 });
+while(workFree != NULL) {
+	Block	 = workFree;
+	workFree = Block->Prev;
+	free(Block);
+	}
+}
+
+// -------------------------------------------------------------------
+// Take Bytes (a multiple of sizeof(max_align_t)) from the top of the
+// workspace, moving on to a new block if the top block is full.  A
+// free block is reused if it is big enough.
+// -------------------------------------------------------------------
+static void * WorkAlloc(size_t Bytes)
+{
+struct workBlock	*Block, **Link;
+size_t				Size;
+void				*Result;
+
+if(workTop == NULL || workTop->Size - workTop->Used < Bytes) {
+	for(Link = &workFree; *Link != NULL && (*Link)->Size < Bytes; Link = &(*Link)->Prev)
+		;
+	if(*Link != NULL) {
+		Block = *Link;
+		*Link = Block->Prev;
+		}
+	else {
+		Size  = Bytes > HGT_WORK_BLOCK ? Bytes : HGT_WORK_BLOCK;
+		Block = malloc(sizeof(struct workBlock) + Size);
+		Block->Size = Size;
+		}
+	Block->Used = 0;
+	Block->Prev = workTop;
+	workTop		= Block;
+	}
+Result = (unsigned char *) workTop->Data + workTop->Used;
+workTop->Used += Bytes;
+return(Result);
+}
@@ -1,10 +1,26 @@
-gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c hgtInit.c 
-gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c ThetaOfT.c 
-gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c GramAtN.c 
-gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c GramNearT.c 
-gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c RSbuildcoeff.c 
-gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c RSremainder.c 
-gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c RSmainTerm.c 
-gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c HardyZcalc.c 
-ar rcs libhgt.a hgtInit.o ThetaOfT.o GramAtN.o GramNearT.o RSbuildcoeff.o RSremainder.o RSmainTerm.o HardyZcalc.o
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c hgtInit.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c hgtPool.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c hgtWork.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c hgtRing.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c hgtStats.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c hgtJob.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c hgtFile.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c hgtBackend.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c hgtQuad.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c hgtSimd.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c hgtFixed.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c hgtTable.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c ThetaOfT.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c GramAtN.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c GramRange.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c GramNearT.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c TuringCalc.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c ZeroRefine.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c RSbuildcoeff.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c RSremainder.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c RSmainTerm.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c HardyZcalc.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c HardyZgrid.c 
+gcc -O2 -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c HardyZstep.c 
+ar rcs libhgt.a hgtInit.o hgtPool.o hgtWork.o hgtRing.o hgtStats.o hgtJob.o hgtFile.o hgtBackend.o hgtQuad.o hgtSimd.o hgtFixed.o hgtTable.o ThetaOfT.o GramAtN.o GramRange.o GramNearT.o TuringCalc.o ZeroRefine.o RSbuildcoeff.o RSremainder.o RSmainTerm.o HardyZcalc.o HardyZgrid.o HardyZstep.o
 